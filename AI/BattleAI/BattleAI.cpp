@@ -22,6 +22,7 @@
 #include "../../lib/spells/ISpellMechanics.h"
 #include "../../lib/battle/BattleAction.h"
 #include "../../lib/battle/BattleStateInfoForRetreat.h"
+#include "../../lib/networkPacks/PacksForClientBattle.h"
 #include "../../lib/battle/CObstacleInstance.h"
 #include "../../lib/StartInfo.h"
 #include "../../lib/CStack.h" // TODO: remove
@@ -60,7 +61,7 @@ void logHexNumbers()
 #endif
 }
 
-void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB)
+void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB)
 {
 	env = ENV;
 	cb = CB;
@@ -74,7 +75,7 @@ void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::share
 	logHexNumbers();
 }
 
-void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB, AutocombatPreferences autocombatPreferences)
+void CBattleAI::initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB, AutocombatPreferences autocombatPreferences)
 {
 	initBattleInterface(ENV, CB);
 	autobattlePreferences = autocombatPreferences;
@@ -141,6 +142,7 @@ void CBattleAI::activeStack(const BattleID & battleID, const CStack * stack )
 
 	BattleAction result = BattleAction::makeDefend(stack);
 
+	DecisionStatistics::DecisionTimer decisionTimer(statistics);
 	auto start = std::chrono::high_resolution_clock::now();
 
 	try
@@ -260,6 +262,12 @@ void CBattleAI::battleStart(const BattleID & battleID, const CCreatureSet *army1
 	skipCastUntilNextBattle = false;
 }
 
+void CBattleAI::battleEnd(const BattleID & battleID, const BattleResult * br, QueryID queryID)
+{
+	LOG_TRACE(logAi);
+	statistics.battleFinished(br->winner == side);
+}
+
 void CBattleAI::print(const std::string &text) const
 {
 	logAi->trace("%s Battle AI[%p]: %s", playerID.toString(), this, text);
@@ -12,6 +12,7 @@
 #include "../../lib/battle/ReachabilityInfo.h"
 #include "PossibleSpellcast.h"
 #include "PotentialTargets.h"
+#include "DecisionStatistics.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
@@ -55,7 +56,7 @@ struct CurrentOffensivePotential
 class CBattleAI : public CBattleGameInterface
 {
 	BattleSide side;
-	std::shared_ptr<CBattleCallback> cb;
+	std::shared_ptr<IBattleCallback> cb;
 	std::shared_ptr<Environment> env;
 
 	//Previous setting of cb
@@ -64,12 +65,14 @@ class CBattleAI : public CBattleGameInterface
 	int movesSkippedByDefense;
 	bool skipCastUntilNextBattle;
 
+	DecisionStatistics statistics;
+
 public:
 	CBattleAI();
 	~CBattleAI();
 
-	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB) override;
-	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB, AutocombatPreferences autocombatPreferences) override;
+	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB) override;
+	void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB, AutocombatPreferences autocombatPreferences) override;
 
 	void activeStack(const BattleID & battleID, const CStack * stack) override; //called when it's turn of that stack
 	void yourTacticPhase(const BattleID & battleID, int distance) override;
@@ -81,11 +84,11 @@ public:
 	BattleAction useHealingTent(const BattleID & battleID, const CStack *stack);
 
 	void battleStart(const BattleID & battleID, const CCreatureSet * army1, const CCreatureSet * army2, int3 tile, const CGHeroInstance * hero1, const CGHeroInstance * hero2, BattleSide side, bool replayAllowed) override;
+	void battleEnd(const BattleID & battleID, const BattleResult * br, QueryID queryID) override;
 	//void actionFinished(const BattleAction &action) override;//occurs AFTER every action taken by any stack or by the hero
 	//void actionStarted(const BattleAction &action) override;//occurs BEFORE every action taken by any stack or by the hero
 	//void battleAttack(const BattleAttack *ba) override; //called when stack is performing attack
 	//void battleStacksAttacked(const std::vector<BattleStackAttacked> & bsa, bool ranged) override; //called when stack receives damage (after battleAttack())
-	//void battleEnd(const BattleResult *br, QueryID queryID) override;
 	//void battleResultsApplied() override; //called when all effects of last battle are applied
 	//void battleNewRoundFirst(int round) override; //called at the beginning of each turn before changes are applied;
 	//void battleNewRound(int round) override; //called at the beginning of each turn, round=-1 is the tactic phase, round=0 is the first "normal" turn
@@ -16,6 +16,7 @@
 #include "tbb/parallel_for.h"
 #include "../../lib/CStopWatch.h"
 #include "../../lib/CThreadHelper.h"
+#include "../../lib/TraceProfiler.h"
 #include "../../lib/mapObjects/CGTownInstance.h"
 #include "../../lib/entities/building/TownFortifications.h"
 #include "../../lib/spells/CSpellHandler.h"
@@ -52,7 +53,7 @@ SpellTypes spellType(const CSpell * spell)
 
 BattleEvaluator::BattleEvaluator(
 	std::shared_ptr<Environment> env,
-	std::shared_ptr<CBattleCallback> cb,
+	std::shared_ptr<IBattleCallback> cb,
 	const battle::Unit * activeStack,
 	PlayerColor playerID,
 	BattleID battleID,
@@ -71,7 +72,7 @@ BattleEvaluator::BattleEvaluator(
 
 BattleEvaluator::BattleEvaluator(
 	std::shared_ptr<Environment> env,
-	std::shared_ptr<CBattleCallback> cb,
+	std::shared_ptr<IBattleCallback> cb,
 	std::shared_ptr<HypotheticBattle> hb,
 	DamageCache & damageCache,
 	const battle::Unit * activeStack,
@@ -153,6 +154,8 @@ std::optional<PossibleSpellcast> BattleEvaluator::findBestCreatureSpell(const CS
 
 BattleAction BattleEvaluator::selectStackAction(const CStack * stack)
 {
+	VCMI_PROFILE_ZONE("BattleEvaluator::selectStackAction");
+
 #if BATTLE_TRACE_LEVEL >= 1
 	logAi->trace("Select stack action");
 #endif
@@ -464,6 +467,8 @@ bool BattleEvaluator::canCastSpell()
 
 bool BattleEvaluator::attemptCastingSpell(const CStack * activeStack)
 {
+	VCMI_PROFILE_ZONE("BattleEvaluator::attemptCastingSpell");
+
 	auto hero = cb->getBattle(battleID)->battleGetMyHero();
 	if(!hero)
 		return false;
@@ -0,0 +1,72 @@
+/*
+ * DecisionStatistics.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "DecisionStatistics.h"
+
+#include "../../lib/json/JsonNode.h"
+
+std::mutex DecisionStatistics::totalsMutex;
+DecisionStatistics::Totals DecisionStatistics::totals;
+
+DecisionStatistics::DecisionTimer::DecisionTimer(DecisionStatistics & owner)
+	: owner(owner)
+	, start(std::chrono::steady_clock::now())
+{
+}
+
+DecisionStatistics::DecisionTimer::~DecisionTimer()
+{
+	auto duration = std::chrono::steady_clock::now() - start;
+	owner.addDecision(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void DecisionStatistics::addDecision(int64_t microseconds)
+{
+	battleDecisionTimes.add(microseconds);
+
+	TLockGuard _(totalsMutex);
+	totals.decisionTimes.add(microseconds);
+}
+
+void DecisionStatistics::describe(JsonNode & result, const SampledStatistics & decisionTimes)
+{
+	result["decisions"].Integer() = decisionTimes.getCount();
+	result["totalTimeUs"].Integer() = decisionTimes.getTotal();
+	if(decisionTimes.getCount() == 0)
+		return;
+
+	result["maxUs"].Integer() = decisionTimes.getMaximum();
+	result["p50Us"].Integer() = decisionTimes.getPercentile(50);
+	result["p90Us"].Integer() = decisionTimes.getPercentile(90);
+	result["p99Us"].Integer() = decisionTimes.getPercentile(99);
+}
+
+void DecisionStatistics::battleFinished(bool victory)
+{
+	JsonNode battle;
+	describe(battle, battleDecisionTimes);
+	battle["victory"].Bool() = victory;
+
+	JsonNode overall;
+	{
+		TLockGuard _(totalsMutex);
+		totals.battles += 1;
+		totals.victories += victory ? 1 : 0;
+
+		overall["battles"].Integer() = totals.battles;
+		overall["victories"].Integer() = totals.victories;
+		describe(overall, totals.decisionTimes);
+	}
+
+	battleDecisionTimes = SampledStatistics(SAMPLE_SIZE);
+
+	logAi->debug("BattleAI battle statistics: %s", battle.toCompactString());
+	logAi->debug("BattleAI total statistics: %s", overall.toCompactString());
+}
@@ -0,0 +1,58 @@
+/*
+ * DecisionStatistics.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../../lib/SampledStatistics.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class JsonNode;
+
+VCMI_LIB_NAMESPACE_END
+
+/// Collects time spent by BattleAI on each stack decision together with outcome of battles.
+/// Summary is logged after each battle so AI-only games can be used to track BattleAI speed and strength
+class DecisionStatistics
+{
+public:
+	/// Measures time from construction until destruction and records it as a single decision
+	class DecisionTimer : boost::noncopyable
+	{
+		DecisionStatistics & owner;
+		std::chrono::steady_clock::time_point start;
+
+	public:
+		explicit DecisionTimer(DecisionStatistics & owner);
+		~DecisionTimer();
+	};
+
+	void addDecision(int64_t microseconds);
+
+	/// Logs statistics of finished battle as well as accumulated statistics of all battles of this process
+	void battleFinished(bool victory);
+
+private:
+	/// Number of decision times kept to estimate percentiles, within single battle and over all battles of the process
+	static constexpr size_t SAMPLE_SIZE = 4096;
+
+	struct Totals
+	{
+		int64_t battles = 0;
+		int64_t victories = 0;
+		SampledStatistics decisionTimes{SAMPLE_SIZE};
+	};
+
+	static void describe(JsonNode & result, const SampledStatistics & decisionTimes);
+
+	SampledStatistics battleDecisionTimes{SAMPLE_SIZE};
+
+	static std::mutex totalsMutex;
+	static Totals totals;
+};
@@ -377,9 +377,12 @@ void AIGateway::objectRemoved(const CGObjectInstance * obj, const PlayerColor &
 	nullkiller->memory->removeFromMemory(obj);
 	nullkiller->objectClusterizer->onObjectRemoved(obj->id);
 
-	if(nullkiller->baseGraph && nullkiller->isObjectGraphAllowed())
+	if(nullkiller->isObjectGraphAllowed())
 	{
-		nullkiller->baseGraph->removeObject(obj);
+		std::lock_guard<std::mutex> lock(Nullkiller::baseGraphMutex);
+
+		if(nullkiller->baseGraph)
+			nullkiller->baseGraph->removeObject(obj);
 	}
 
 	if(obj->ID == Obj::HERO && obj->tempOwner == playerID)
@@ -24,6 +24,8 @@
 #include "../Goals/Composition.h"
 #include "../../../lib/CPlayerState.h"
 #include "../../lib/StartInfo.h"
+#include "../../../lib/TraceProfiler.h"
+#include "../../../lib/ScopeGuard.h"
 
 namespace NKAI
 {
@@ -32,6 +34,7 @@ using namespace Goals;
 
 // while we play vcmieagles graph can be shared
 std::unique_ptr<ObjectGraph> Nullkiller::baseGraph;
+std::mutex Nullkiller::baseGraphMutex;
 
 Nullkiller::Nullkiller()
 	:activeHero(nullptr), scanDepth(ScanDepth::MAIN_FULL), useHeroChain(true)
@@ -78,7 +81,10 @@ void Nullkiller::init(std::shared_ptr<CCallback> cb, AIGateway * gateway)
 		openMap = false;
 	}
 
-	baseGraph.reset();
+	{
+		std::lock_guard<std::mutex> lock(baseGraphMutex);
+		baseGraph.reset();
+	}
 
 	priorityEvaluator.reset(new PriorityEvaluator(this));
 	priorityEvaluators.reset(
@@ -198,6 +204,8 @@ Goals::TTaskVec Nullkiller::buildPlan(TGoalVec & tasks) const
 
 void Nullkiller::decompose(Goals::TGoalVec & result, Goals::TSubgoal behavior, int decompositionMaxDepth) const
 {
+	VCMI_PROFILE_ZONE("Nullkiller::decompose");
+
 	boost::this_thread::interruption_point();
 
 	logAi->debug("Checking behavior %s", behavior->toString());
@@ -225,15 +233,22 @@ void Nullkiller::resetAiState()
 	useHeroChain = true;
 	objectClusterizer->reset();
 
-	if(!baseGraph && isObjectGraphAllowed())
+	if(isObjectGraphAllowed())
 	{
-		baseGraph = std::make_unique<ObjectGraph>();
-		baseGraph->updateGraph(this);
+		std::lock_guard<std::mutex> lock(baseGraphMutex);
+
+		if(!baseGraph)
+		{
+			baseGraph = std::make_unique<ObjectGraph>();
+			baseGraph->updateGraph(this);
+		}
 	}
 }
 
 void Nullkiller::updateAiState(int pass, bool fast)
 {
+	VCMI_PROFILE_ZONE("Nullkiller::updateAiState");
+
 	boost::this_thread::interruption_point();
 
 	std::unique_lock lockGuard(aiStateMutex);
@@ -250,8 +265,11 @@ void Nullkiller::updateAiState(int pass, bool fast)
 	{
 		memory->removeInvisibleObjects(cb.get());
 
-		dangerHitMap->updateHitMap();
-		dangerHitMap->calculateTileOwners();
+		{
+			VCMI_PROFILE_ZONE("Nullkiller::updateHitMap");
+			dangerHitMap->updateHitMap();
+			dangerHitMap->calculateTileOwners();
+		}
 
 		boost::this_thread::interruption_point();
 
@@ -284,10 +302,14 @@ void Nullkiller::updateAiState(int pass, bool fast)
 
 		boost::this_thread::interruption_point();
 
-		pathfinder->updatePaths(activeHeroes, cfg);
+		{
+			VCMI_PROFILE_ZONE("Nullkiller::updatePaths");
+			pathfinder->updatePaths(activeHeroes, cfg);
+		}
 
 		if(isObjectGraphAllowed())
 		{
+			VCMI_PROFILE_ZONE("Nullkiller::updateGraphs");
 			pathfinder->updateGraphs(
 				activeHeroes,
 				scanDepth == ScanDepth::SMALL ? 255 : 10,
@@ -344,7 +366,13 @@ HeroLockedReason Nullkiller::getHeroLockedReason(const CGHeroInstance * hero) co
 
 void Nullkiller::makeTurn()
 {
-	boost::lock_guard<boost::mutex> sharedStorageLock(AISharedStorage::locker);
+	VCMI_PROFILE_ZONE("Nullkiller::makeTurn");
+
+	// let other AI players making turn at the same time reuse our pathfinding nodes once we are done
+	auto releaseNodes = vstd::makeScopeGuard([this]()
+	{
+		pathfinder->releaseNodes();
+	});
 
 	const int MAX_DEPTH = 10;
 	const float FAST_TASK_MINIMAL_PRIORITY = 0.7f;
@@ -397,7 +425,11 @@ void Nullkiller::makeTurn()
 			decompose(bestTasks, sptr(StartupBehavior()), 1);
 		}
 
-		auto selectedTasks = buildPlan(bestTasks);
+		Goals::TTaskVec selectedTasks;
+		{
+			VCMI_PROFILE_ZONE("Nullkiller::buildPlan");
+			selectedTasks = buildPlan(bestTasks);
+		}
 
 		logAi->debug("Decision madel in %ld", timeElapsed(start));
 
@@ -514,6 +546,8 @@ HeroRole Nullkiller::getTaskRole(Goals::TTask task) const
 
 bool Nullkiller::executeTask(Goals::TTask task)
 {
+	VCMI_PROFILE_ZONE("Nullkiller::executeTask");
+
 	auto start = std::chrono::high_resolution_clock::now();
 	std::string taskDescr = task->toString();
 
@@ -81,6 +81,7 @@ private:
 
 public:
 	static std::unique_ptr<ObjectGraph> baseGraph;
+	static std::mutex baseGraphMutex;
 
 	std::unique_ptr<DangerHitMapAnalyzer> dangerHitMap;
 	std::unique_ptr<BuildAnalyzer> buildAnalyzer;
@@ -25,12 +25,8 @@
 namespace NKAI
 {
 
-std::shared_ptr<boost::multi_array<AIPathNode, 4>> AISharedStorage::shared;
-uint32_t AISharedStorage::version = 0;
+std::vector<std::shared_ptr<AISharedStorage::NodesArray>> AISharedStorage::pool;
 boost::mutex AISharedStorage::locker;
-std::set<int3> committedTiles;
-std::set<int3> committedTilesInitial;
-
 
 const uint64_t FirstActorMask = 1;
 const uint64_t MIN_ARMY_STRENGTH_FOR_CHAIN = 5000;
@@ -39,36 +35,106 @@ const uint64_t CHAIN_MAX_DEPTH = 4;
 
 const bool DO_NOT_SAVE_TO_COMMITTED_TILES = false;
 
-AISharedStorage::AISharedStorage(int3 sizes)
+AISharedStorage::NodesArray::NodesArray(int3 sizes)
+	: nodes(boost::extents[sizes.z][sizes.x][sizes.y][AIPathfinding::NUM_CHAINS])
 {
-	if(!shared){
-		shared.reset(new boost::multi_array<AIPathNode, 4>(
-			boost::extents[sizes.z][sizes.x][sizes.y][AIPathfinding::NUM_CHAINS]));
+	int3 pos;
 
-		nodes = shared;
-
-		foreach_tile_pos([&](const int3 & pos)
+	for(pos.z = 0; pos.z < sizes.z; ++pos.z)
+	{
+		for(pos.x = 0; pos.x < sizes.x; ++pos.x)
+		{
+			for(pos.y = 0; pos.y < sizes.y; ++pos.y)
 			{
-				for(auto i = 0; i < AIPathfinding::NUM_CHAINS; i++)
+				for(auto & node : nodes[pos.z][pos.x][pos.y])
 				{
-					auto & node = get(pos)[i];
-						
 					node.version = -1;
 					node.coord = pos;
 				}
-			});
+			}
+		}
 	}
-	else
-		nodes = shared;
+}
+
+AISharedStorage::AISharedStorage(int3 sizes)
+	: sizes(sizes), leased(false), version(0)
+{
 }
 
 AISharedStorage::~AISharedStorage()
 {
-	nodes.reset();
-	if(shared && shared.use_count() == 1)
+	release();
+
+	boost::lock_guard<boost::mutex> lock(locker);
+
+	// free memory of arrays that are not used by other AI players
+	vstd::erase_if(pool, [](const std::shared_ptr<NodesArray> & array)
+	{
+		return !array->leased;
+	});
+}
+
+void AISharedStorage::startCalculation()
+{
+	if(!leased)
+	{
+		boost::lock_guard<boost::mutex> lock(locker);
+
+		auto available = std::find_if(pool.begin(), pool.end(), [this](const std::shared_ptr<NodesArray> & array) -> bool
+		{
+			auto shape = array->nodes.shape();
+
+			return !array->leased
+				&& shape[0] == sizes.z
+				&& shape[1] == sizes.x
+				&& shape[2] == sizes.y;
+		});
+
+		if(available != pool.end())
+		{
+			nodes = *available;
+		}
+		else
+		{
+			nodes = std::make_shared<NodesArray>(sizes);
+			pool.push_back(nodes);
+
+			logAi->debug("Allocated AI pathfinding nodes array, %d arrays in use", pool.size());
+		}
+
+		nodes->leased = true;
+		leased = true;
+	}
+
+	version = ++nodes->version;
+}
+
+void AISharedStorage::release()
+{
+	if(!leased)
+		return;
+
+	boost::lock_guard<boost::mutex> lock(locker);
+
+	nodes->leased = false;
+	leased = false;
+
+	// once no player makes turn, only released array is kept for the next turn,
+	// arrays allocated for simultaneous turns are freed
+	bool anyLeased = vstd::contains_if(pool, [](const std::shared_ptr<NodesArray> & array)
 	{
-		shared.reset();
+		return array->leased;
+	});
+
+	if(!anyLeased)
+	{
+		vstd::erase_if(pool, [this](const std::shared_ptr<NodesArray> & array)
+		{
+			return array != nodes;
+		});
 	}
+
+	nodes.reset();
 }
 
 void AIPathNode::addSpecialAction(std::shared_ptr<const SpecialAction> action)
@@ -101,12 +167,17 @@ AINodeStorage::AINodeStorage(const Nullkiller * ai, const int3 & Sizes)
 
 AINodeStorage::~AINodeStorage() = default;
 
+void AINodeStorage::releaseNodes()
+{
+	nodes.release();
+}
+
 void AINodeStorage::initialize(const PathfinderOptions & options, const CGameState * gs)
 {
 	if(heroChainPass != EHeroChainPass::INITIAL)
 		return;
 
-	AISharedStorage::version++;
+	nodes.startCalculation();
 
 	//TODO: fix this code duplication with NodeStorage::initialize, problem is to keep `resetTile` inline
 	const PlayerColor fowPlayer = ai->playerID;
@@ -182,10 +253,10 @@ std::optional<AIPathNode *> AINodeStorage::getOrCreateNode(
 	{
 		AIPathNode & node = chains[i + bucketOffset];
 
-		if(node.version != AISharedStorage::version)
+		if(node.version != nodes.getVersion())
 		{
 			node.reset(layer, getAccessibility(pos, layer));
-			node.version = AISharedStorage::version;
+			node.version = nodes.getVersion();
 			node.actor = actor;
 
 			return &node;
@@ -707,7 +778,7 @@ void HeroChainCalculationTask::calculateHeroChain(
 {
 	for(AIPathNode * node : variants)
 	{
-		if(node == srcNode || !node->actor || node->version != AISharedStorage::version)
+		if(node == srcNode || !node->actor || node->version != storage.getNodesVersion())
 			continue;
 
 		if((node->actor->chainMask & chainMask) == 0 && (srcNode->actor->chainMask & chainMask) == 0)
@@ -1379,11 +1450,14 @@ bool AINodeStorage::isOtherChainBetter(
 
 bool AINodeStorage::isTileAccessible(const HeroPtr & hero, const int3 & pos, const EPathfindingLayer layer) const
 {
+	if(!nodes.isLeased())
+		return false;
+
 	auto chains = nodes.get(pos);
 
 	for(const AIPathNode & node : chains)
 	{
-		if(node.version == AISharedStorage::version
+		if(node.version == nodes.getVersion()
 			&& node.layer == layer
 			&& node.action != EPathNodeAction::UNKNOWN 
 			&& node.actor
@@ -1398,12 +1472,15 @@ bool AINodeStorage::isTileAccessible(const HeroPtr & hero, const int3 & pos, con
 
 void AINodeStorage::calculateChainInfo(std::vector<AIPath> & paths, const int3 & pos, bool isOnLand) const
 {
+	if(!nodes.isLeased())
+		return;
+
 	auto layer = isOnLand ? EPathfindingLayer::LAND : EPathfindingLayer::SAIL;
 	auto chains = nodes.get(pos);
 
 	for(const AIPathNode & node : chains)
 	{
-		if(node.version != AISharedStorage::version
+		if(node.version != nodes.getVersion()
 			|| node.layer != layer
 			|| node.action == EPathNodeAction::UNKNOWN
 			|| !node.actor
@@ -149,21 +149,52 @@ enum EHeroChainPass
 
 class AISharedStorage
 {
-	// 1-3 - position on map[z][x][y]
-	// 4 - chain + layer (normal, battle, spellcast and combinations, water, air)
-	static std::shared_ptr<boost::multi_array<AIPathNode, 4>> shared;
-	std::shared_ptr<boost::multi_array<AIPathNode, 4>> nodes;
-public:
+	struct NodesArray
+	{
+		// 1-3 - position on map[z][x][y]
+		// 4 - chain + layer (normal, battle, spellcast and combinations, water, air)
+		boost::multi_array<AIPathNode, 4> nodes;
+		uint32_t version = 0;
+		bool leased = false;
+
+		NodesArray(int3 sizes);
+	};
+
+	// Node arrays are large, so they are shared between all AI players of the process.
+	// Array is leased by a player from start of path calculation until the end of its turn.
+	// Additional arrays are only allocated while several players make turns simultaneously and freed after these turns end
+	static std::vector<std::shared_ptr<NodesArray>> pool;
 	static boost::mutex locker;
-	static uint32_t version;
 
+	int3 sizes;
+	std::shared_ptr<NodesArray> nodes;
+	bool leased;
+	uint32_t version;
+
+public:
 	AISharedStorage(int3 mapSize);
 	~AISharedStorage();
 
+	/// Acquires node array for exclusive use if not acquired yet and invalidates all nodes in it
+	void startCalculation();
+
+	/// Returns node array to pool. Paths are empty until next calculation
+	void release();
+
+	bool isLeased() const
+	{
+		return leased;
+	}
+
+	uint32_t getVersion() const
+	{
+		return version;
+	}
+
 	STRONG_INLINE
 	boost::detail::multi_array::sub_array<AIPathNode, 1> get(int3 tile) const
 	{
-		return (*nodes)[tile.z][tile.x][tile.y];
+		return nodes->nodes[tile.z][tile.x][tile.y];
 	}
 };
 
@@ -185,6 +216,8 @@ private:
 	int heroChainMaxTurns;
 	PlayerColor playerID;
 	uint8_t turnDistanceLimit[2];
+	mutable std::set<int3> committedTiles;
+	std::set<int3> committedTilesInitial;
 
 public:
 	/// more than 1 chain layer for each hero allows us to have more than 1 path to each tile so we can chose more optimal one.	
@@ -193,6 +226,14 @@ public:
 
 	void initialize(const PathfinderOptions & options, const CGameState * gs) override;
 
+	/// Returns node array to shared pool once AI player no longer needs its paths
+	void releaseNodes();
+
+	uint32_t getNodesVersion() const
+	{
+		return nodes.getVersion();
+	}
+
 	bool increaseHeroChainTurnLimit();
 	bool selectFirstActor();
 	bool selectNextActor();
@@ -314,7 +355,7 @@ public:
 
 		for(AIPathNode & node : chains)
 		{
-			if(node.version != AISharedStorage::version || node.layer != layer)
+			if(node.version != nodes.getVersion() || node.layer != layer)
 				continue;
 
 			fn(node);
@@ -331,7 +372,7 @@ public:
 
 		for(AIPathNode & node : chains)
 		{
-			if(node.version != AISharedStorage::version || node.layer != layer)
+			if(node.version != nodes.getVersion() || node.layer != layer)
 				continue;
 
 			if(predicate(node))
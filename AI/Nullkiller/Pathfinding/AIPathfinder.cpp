@@ -17,8 +17,6 @@
 namespace NKAI
 {
 
-std::map<ObjectInstanceID, std::unique_ptr<GraphPaths>>  AIPathfinder::heroGraphs;
-
 AIPathfinder::AIPathfinder(CPlayerSpecificInfoCallback * cb, Nullkiller * ai)
 	:cb(cb), ai(ai)
 {
@@ -29,6 +27,12 @@ void AIPathfinder::init()
 	storage.reset();
 }
 
+void AIPathfinder::releaseNodes()
+{
+	if(storage)
+		storage->releaseNodes();
+}
+
 bool AIPathfinder::isTileAccessible(const HeroPtr & hero, const int3 & tile) const
 {
 	return storage->isTileAccessible(hero, tile, EPathfindingLayer::LAND)
@@ -55,7 +55,11 @@ std::shared_ptr<SpecialAction> getCompositeAction(
 
 void GraphPaths::calculatePaths(const CGHeroInstance * targetHero, const Nullkiller * ai, uint8_t scanDepth)
 {
-	graph.copyFrom(*ai->baseGraph);
+	{
+		std::lock_guard<std::mutex> lock(Nullkiller::baseGraphMutex);
+		graph.copyFrom(*ai->baseGraph);
+	}
+
 	graph.connectHeroes(ai);
 
 	visualKey = std::to_string(ai->playerID) + ":" + targetHero->getNameTranslated();
@@ -42,6 +42,9 @@ const double SAFE_ATTACK_CONSTANT = 1.5;
 thread_local CCallback * cb = nullptr;
 thread_local VCAI * ai = nullptr;
 
+//pathfinder storage is shared between all VCAI players so only one of them can make turn at a time
+static boost::mutex turnMutex;
+
 //std::map<int, std::map<int, int> > HeroView::infosCount;
 
 //helper RAII to manage global ai/cb ptrs
@@ -772,6 +775,8 @@ void VCAI::makeTurn()
 	auto day = cb->getDate(Date::DAY);
 	logAi->info("Player %d (%s) starting turn, day %d", playerID, playerID.toString(), day);
 
+	// must be locked before game state, otherwise waiting player would block application of packs for active one
+	boost::lock_guard<boost::mutex> turnLock(turnMutex);
 	boost::shared_lock gsLock(CGameState::mutex);
 	setThreadName("VCAI::makeTurn");
 
@@ -356,6 +356,11 @@ std::shared_ptr<const CPathsInfo> CCallback::getPathsInfo(const CGHeroInstance *
 	return cl->getPathsInfo(h);
 }
 
+void CCallback::precalculatePaths(const std::vector<const CGHeroInstance *> & heroes)
+{
+	cl->precalculatePaths(heroes);
+}
+
 std::optional<PlayerColor> CCallback::getPlayerID() const
 {
 	return CBattleCallback::getPlayerID();
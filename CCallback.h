@@ -153,6 +153,7 @@ public:
 	virtual bool canMoveBetween(const int3 &a, const int3 &b);
 	virtual int3 getGuardingCreaturePosition(int3 tile);
 	virtual std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
+	virtual void precalculatePaths(const std::vector<const CGHeroInstance *> & heroes);
 
 	std::optional<PlayerColor> getPlayerID() const override;
 
@@ -0,0 +1,213 @@
+/*
+ * BattleScenario.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleScenario.h"
+
+#include "../lib/CHeroHandler.h"
+#include "../lib/StartInfo.h"
+#include "../lib/TerrainHandler.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/mapObjectConstructors/AObjectTypeHandler.h"
+#include "../lib/mapObjectConstructors/CObjectClassesHandler.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/mapObjects/CGTownInstance.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapping/CMapEditManager.h"
+#include "../lib/modding/IdentifierStorage.h"
+#include "../lib/modding/ModScope.h"
+#include "../lib/serializer/JsonDeserializer.h"
+
+static constexpr int MAP_SIZE = 16;
+
+/// Heroes are placed far enough from each other so they will not interact before battle
+static const int3 ATTACKER_POSITION(3, 3, 0);
+static const int3 DEFENDER_POSITION(10, 10, 0);
+
+BattleScenario::BattleScenario(const JsonNode & config)
+	: config(config)
+{
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+	{
+		const JsonNode & sideConfig = config[side == BattleSide::ATTACKER ? "attacker" : "defender"];
+
+		sides[side].aiName = sideConfig["ai"].isNull() ? "BattleAI" : sideConfig["ai"].String();
+		sides[side].hero = sideConfig["hero"];
+		sides[side].town = sideConfig["town"];
+	}
+
+	if(sides[BattleSide::ATTACKER].hero.isNull())
+		throw std::runtime_error("Attacker must have a hero!");
+
+	if(!sides[BattleSide::ATTACKER].town.isNull())
+		throw std::runtime_error("Only defender can have a town!");
+
+	if(sides[BattleSide::DEFENDER].hero.isNull() && sides[BattleSide::DEFENDER].town.isNull())
+		throw std::runtime_error("Defender must have a hero or a town!");
+}
+
+PlayerColor BattleScenario::sideToPlayer(BattleSide side)
+{
+	return side == BattleSide::ATTACKER ? PlayerColor(0) : PlayerColor(1);
+}
+
+const std::string & BattleScenario::getAIName(BattleSide side) const
+{
+	return sides[side].aiName;
+}
+
+void BattleScenario::setAIName(BattleSide side, const std::string & aiName)
+{
+	sides[side].aiName = aiName;
+}
+
+StartInfo BattleScenario::createStartInfo() const
+{
+	StartInfo si;
+	si.mode = EStartMode::NEW_GAME;
+	si.mapname = "battle simulator";
+	si.difficulty = config["difficulty"].isNull() ? 1 : static_cast<ui8>(config["difficulty"].Integer());
+
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+	{
+		PlayerSettings & pset = si.playerInfos[sideToPlayer(side)];
+		pset.color = sideToPlayer(side);
+		pset.compOnly = true;
+		pset.castle = FactionID::RANDOM;
+		pset.hero = HeroTypeID::NONE;
+		// starting bonus must not affect heroes taking part in battle
+		pset.bonus = PlayerStartingBonus::GOLD;
+	}
+	return si;
+}
+
+CGHeroInstance * BattleScenario::createHero(CMap & map, IGameCallback * cb, BattleSide side, const int3 & visitablePosition) const
+{
+	const JsonNode & options = sides[side].hero;
+
+	auto rawHeroType = VLC->identifiers()->getIdentifier(ModScope::scopeMap(), "hero", options["type"].String());
+	if(!rawHeroType)
+		throw std::runtime_error("Unknown hero type: " + options["type"].String());
+
+	HeroTypeID heroType(rawHeroType.value());
+	auto handler = VLC->objtypeh->getHandlerFor(Obj::HERO, heroType.toHeroType()->heroClass->getIndex());
+	auto * hero = dynamic_cast<CGHeroInstance *>(handler->create(cb, handler->getTemplates().front()));
+
+	hero->ID = Obj::HERO;
+	hero->setHeroType(heroType);
+
+	// hero is described in the same format as hero object in json maps
+	JsonNode objectConfig;
+	objectConfig["options"] = options;
+	JsonDeserializer deserializer(nullptr, objectConfig);
+	static_cast<CGObjectInstance *>(hero)->serializeJson(deserializer);
+	{
+		auto guard = deserializer.enterStruct("options");
+		hero->serializeJsonArtifacts(deserializer, "artifacts");
+	}
+
+	hero->tempOwner = sideToPlayer(side);
+	hero->pos = visitablePosition;
+	hero->pos += hero->getVisitableOffset();
+	map.getEditManager()->insertObject(hero);
+	map.addNewArtifactInstance(*hero);
+	return hero;
+}
+
+CGTownInstance * BattleScenario::createTown(CMap & map, IGameCallback * cb, BattleSide side, const int3 & position) const
+{
+	const JsonNode & options = sides[side].town;
+
+	auto rawFaction = VLC->identifiers()->getIdentifier(ModScope::scopeMap(), "faction", options["type"].String());
+	if(!rawFaction)
+		throw std::runtime_error("Unknown town type: " + options["type"].String());
+
+	auto handler = VLC->objtypeh->getHandlerFor(Obj::TOWN, rawFaction.value());
+	auto * town = dynamic_cast<CGTownInstance *>(handler->create(cb, handler->getTemplates().front()));
+
+	JsonNode objectConfig;
+	objectConfig["options"] = options;
+	JsonDeserializer deserializer(nullptr, objectConfig);
+	static_cast<CGObjectInstance *>(town)->serializeJson(deserializer);
+
+	town->tempOwner = sideToPlayer(side);
+	town->pos = position;
+	map.getEditManager()->insertObject(town);
+	return town;
+}
+
+std::unique_ptr<CMap> BattleScenario::createMap(IGameCallback * cb) const
+{
+	auto map = std::make_unique<CMap>(cb);
+	map->name.appendRawString("Battle simulator");
+	map->width = MAP_SIZE;
+	map->height = MAP_SIZE;
+	map->twoLevel = false;
+	map->initTerrain();
+
+	std::string terrainName = config["terrain"].isNull() ? "grass" : config["terrain"].String();
+	auto rawTerrain = VLC->identifiers()->getIdentifier(ModScope::scopeMap(), "terrain", terrainName);
+	if(!rawTerrain)
+		throw std::runtime_error("Unknown terrain: " + terrainName);
+
+	const auto * terrain = VLC->terrainTypeHandler->getById(TerrainId(rawTerrain.value()));
+	for(int x = 0; x < MAP_SIZE; ++x)
+		for(int y = 0; y < MAP_SIZE; ++y)
+			map->getTile(int3(x, y, 0)).terType = terrain;
+
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+	{
+		PlayerInfo & info = map->players[sideToPlayer(side).getNum()];
+		info.canComputerPlay = true;
+		info.team = TeamID(static_cast<int>(side));
+	}
+
+	createHero(*map, cb, BattleSide::ATTACKER, ATTACKER_POSITION);
+
+	int3 defenderPosition = DEFENDER_POSITION;
+	if(!sides[BattleSide::DEFENDER].town.isNull())
+		defenderPosition = createTown(*map, cb, BattleSide::DEFENDER, DEFENDER_POSITION)->visitablePos();
+
+	// defender standing at visitable tile of town becomes its visiting hero on game start
+	if(!sides[BattleSide::DEFENDER].hero.isNull())
+		createHero(*map, cb, BattleSide::DEFENDER, defenderPosition);
+
+	map->calculateGuardingGreaturePositions();
+	return map;
+}
+
+BattleScenarioMapService::BattleScenarioMapService(const BattleScenario & scenario)
+	: scenario(scenario)
+{
+}
+
+std::unique_ptr<CMap> BattleScenarioMapService::loadMap(const ResourcePath & name, IGameCallback * cb) const
+{
+	return scenario.createMap(cb);
+}
+
+std::unique_ptr<CMapHeader> BattleScenarioMapService::loadMapHeader(const ResourcePath & name) const
+{
+	throw std::runtime_error("Battle scenario does not provide map header");
+}
+
+std::unique_ptr<CMap> BattleScenarioMapService::loadMap(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding, IGameCallback * cb) const
+{
+	throw std::runtime_error("Battle scenario can not load map from memory");
+}
+
+std::unique_ptr<CMapHeader> BattleScenarioMapService::loadMapHeader(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding) const
+{
+	throw std::runtime_error("Battle scenario does not provide map header");
+}
+
+void BattleScenarioMapService::saveMap(const std::unique_ptr<CMap> & map, boost::filesystem::path fullPath) const
+{
+	throw std::runtime_error("Battle scenario can not save map");
+}
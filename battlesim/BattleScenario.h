@@ -0,0 +1,71 @@
+/*
+ * BattleScenario.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/battle/BattleSide.h"
+#include "../lib/constants/EntityIdentifiers.h"
+#include "../lib/int3.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/mapping/CMapService.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CGHeroInstance;
+class CGTownInstance;
+class CMap;
+class IGameCallback;
+struct StartInfo;
+VCMI_LIB_NAMESPACE_END
+
+/// Description of a single battle setup, loaded from json file:
+/// terrain, difficulty and for each side name of battle AI, hero with its army and optional town of defender
+class BattleScenario
+{
+	struct SideConfig
+	{
+		std::string aiName;
+		JsonNode hero;
+		JsonNode town;
+	};
+
+	JsonNode config;
+	BattleSideArray<SideConfig> sides;
+
+	CGHeroInstance * createHero(CMap & map, IGameCallback * cb, BattleSide side, const int3 & visitablePosition) const;
+	CGTownInstance * createTown(CMap & map, IGameCallback * cb, BattleSide side, const int3 & position) const;
+
+public:
+	explicit BattleScenario(const JsonNode & config);
+
+	static PlayerColor sideToPlayer(BattleSide side);
+
+	const std::string & getAIName(BattleSide side) const;
+	void setAIName(BattleSide side, const std::string & aiName);
+
+	/// Creates start options of AI-only game with one player for each side of the battle
+	StartInfo createStartInfo() const;
+
+	/// Creates small map on which all heroes and towns of the scenario are placed
+	std::unique_ptr<CMap> createMap(IGameCallback * cb) const;
+};
+
+/// Map service that provides map of battle scenario instead of loading it from file
+class BattleScenarioMapService : public IMapService
+{
+	const BattleScenario & scenario;
+
+public:
+	explicit BattleScenarioMapService(const BattleScenario & scenario);
+
+	std::unique_ptr<CMap> loadMap(const ResourcePath & name, IGameCallback * cb) const override;
+	std::unique_ptr<CMapHeader> loadMapHeader(const ResourcePath & name) const override;
+	std::unique_ptr<CMap> loadMap(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding, IGameCallback * cb) const override;
+	std::unique_ptr<CMapHeader> loadMapHeader(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding) const override;
+	void saveMap(const std::unique_ptr<CMap> & map, boost::filesystem::path fullPath) const override;
+};
@@ -0,0 +1,335 @@
+/*
+ * BattleSimulator.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleSimulator.h"
+
+#include "BattleScenario.h"
+#include "SimulatedBattleCallback.h"
+
+#include "../server/CGameHandler.h"
+#include "../server/CVCMIServer.h"
+#include "../server/battles/BattleProcessor.h"
+
+#include "../lib/CGameInterface.h"
+#include "../lib/CPlayerState.h"
+#include "../lib/CRandomGenerator.h"
+#include "../lib/CStack.h"
+#include "../lib/LoadProgress.h"
+#include "../lib/StartInfo.h"
+#include "../lib/battle/BattleInfo.h"
+#include "../lib/gameState/CGameState.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/mapObjects/CGTownInstance.h"
+#include "../lib/networkPacks/PacksForClientBattle.h"
+
+/// Upper limit of actions in a single battle, protects simulator from battles that never end
+static constexpr int MAX_BATTLE_STEPS = 10000;
+
+namespace
+{
+
+struct BattleParticipant
+{
+	PlayerColor player;
+	std::shared_ptr<SimulatedBattleCallback> callback;
+	std::shared_ptr<SimulatedEnvironment> environment;
+	std::shared_ptr<CBattleGameInterface> ai;
+};
+
+/// Game handler that forwards battle events to battle AI's directly instead of sending them to clients
+class SimulatorGameHandler : public CGameHandler
+{
+public:
+	BattleSideArray<BattleParticipant> participants;
+
+	BattleID battleID = BattleID::NONE;
+	std::optional<ui32> pendingStack;
+	std::optional<BattleResult> result;
+	int rounds = 0;
+
+	using CGameHandler::CGameHandler;
+	using CGameHandler::sendAndApply;
+
+	~SimulatorGameHandler()
+	{
+		// AI's may access game state during destruction
+		for(auto & participant : participants)
+			participant.ai.reset();
+	}
+
+	void sendAndApply(CPackForClient * pack) override
+	{
+		CGameHandler::sendAndApply(pack);
+
+		if(auto * start = dynamic_cast<BattleStart *>(pack))
+			onBattleStarted(*start);
+		else if(auto * activeStack = dynamic_cast<BattleSetActiveStack *>(pack))
+		{
+			if(activeStack->askPlayerInterface)
+				pendingStack = activeStack->stack;
+		}
+		else if(auto * battleResult = dynamic_cast<BattleResult *>(pack))
+			onBattleResult(*battleResult);
+	}
+
+private:
+	void onBattleStarted(const BattleStart & pack)
+	{
+		const BattleInfo * info = pack.info;
+		battleID = pack.battleID;
+
+		for(auto & participant : participants)
+			participant.callback->onBattleStarted(info);
+
+		const auto & attacker = info->getSide(BattleSide::ATTACKER);
+		const auto & defender = info->getSide(BattleSide::DEFENDER);
+
+		for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+			participants[side].ai->battleStart(battleID, attacker.armyObject, defender.armyObject, info->tile, attacker.hero, defender.hero, side, info->replayAllowed);
+	}
+
+	void onBattleResult(const BattleResult & pack)
+	{
+		// battle of AI-only players is removed immediately after result is applied, collect its state now
+		result = pack;
+		rounds = gameState()->getBattle(pack.battleID)->round;
+		pendingStack.reset();
+
+		for(auto & participant : participants)
+		{
+			participant.ai->battleEnd(pack.battleID, &pack, QueryID::NONE);
+			participant.callback->onBattleEnded(pack.battleID);
+		}
+	}
+};
+
+int64_t toMicroseconds(std::chrono::steady_clock::duration duration)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+void describeDecisionTimes(JsonNode & result, const SampledStatistics & decisionTimes)
+{
+	const uint64_t decisions = decisionTimes.getCount();
+	result["decisions"].Integer() = decisions;
+	result["averageUs"].Integer() = decisions ? decisionTimes.getTotal() / static_cast<int64_t>(decisions) : 0;
+	result["maxUs"].Integer() = decisionTimes.getMaximum();
+	result["p50Us"].Integer() = decisionTimes.getPercentile(50);
+	result["p90Us"].Integer() = decisionTimes.getPercentile(90);
+	result["p99Us"].Integer() = decisionTimes.getPercentile(99);
+}
+
+}
+
+BattleSimulator::BattleSimulator(const BattleScenario & scenario)
+	: scenario(scenario)
+	, server(std::make_unique<CVCMIServer>(0, false))
+{
+}
+
+BattleSimulator::~BattleSimulator() = default;
+
+BattleSimulator::BattleOutcome BattleSimulator::simulateBattle(std::optional<int> seed)
+{
+	BattleOutcome outcome;
+
+	SimulatorGameHandler gh(server.get());
+	if(seed)
+		gh.randomNumberGenerator->setSeed(*seed);
+
+	StartInfo si = scenario.createStartInfo();
+	BattleScenarioMapService mapService(scenario);
+	Load::ProgressAccumulator progressTracking;
+	gh.init(&si, progressTracking, mapService);
+
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+	{
+		auto & participant = gh.participants[side];
+		participant.player = BattleScenario::sideToPlayer(side);
+		participant.callback = std::make_shared<SimulatedBattleCallback>(participant.player);
+		participant.environment = std::make_shared<SimulatedEnvironment>(&gh, participant.callback);
+		participant.ai = CDynLibHandler::getNewBattleAI(scenario.getAIName(side));
+		participant.ai->initBattleInterface(participant.environment, participant.callback);
+	}
+
+	auto battleStart = std::chrono::steady_clock::now();
+
+	const auto * attackerHero = gh.getPlayerState(BattleScenario::sideToPlayer(BattleSide::ATTACKER))->getHeroes().front();
+	const auto * defenderState = gh.getPlayerState(BattleScenario::sideToPlayer(BattleSide::DEFENDER));
+
+	// start battle in the same way as it happens when hero visits enemy town or attacks enemy hero on adventure map
+	if(!defenderState->getTowns().empty())
+		defenderState->getTowns().front()->onHeroVisit(attackerHero);
+	else
+		gh.startBattle(attackerHero, defenderState->getHeroes().front());
+
+	for(int step = 0; step < MAX_BATTLE_STEPS && !gh.result; ++step)
+	{
+		const BattleInfo * battle = gh.gameState()->getBattle(gh.battleID);
+		if(!battle)
+			break;
+
+		BattleSide actingSide;
+		std::optional<BattleAction> fallbackAction;
+
+		if(battle->tacticDistance)
+		{
+			actingSide = battle->tacticsSide;
+			gh.participants[actingSide].ai->yourTacticPhase(gh.battleID, battle->tacticDistance);
+			fallbackAction = BattleAction::makeEndOFTacticPhase(actingSide);
+		}
+		else if(gh.pendingStack)
+		{
+			const CStack * stack = battle->battleGetStackByID(*gh.pendingStack, false);
+			gh.pendingStack.reset();
+
+			// hypnotized stack is controlled by opposite side, same as in client
+			actingSide = stack->unitSide();
+			if(stack->hasBonusOfType(BonusType::HYPNOTIZED))
+				actingSide = battle->otherSide(actingSide);
+
+			auto decisionStart = std::chrono::steady_clock::now();
+			gh.participants[actingSide].ai->activeStack(gh.battleID, stack);
+			sides[actingSide].decisionTimes.add(toMicroseconds(std::chrono::steady_clock::now() - decisionStart));
+
+			fallbackAction = BattleAction::makeDefend(stack);
+		}
+		else
+		{
+			logGlobal->error("Battle simulation stalled: no unit is waiting for action");
+			break;
+		}
+
+		PlayerColor player = gh.participants[actingSide].player;
+		bool actionAccepted = false;
+		for(const auto & action : gh.participants[actingSide].callback->takePendingActions())
+		{
+			if(gh.result)
+				break;
+			actionAccepted |= gh.battles->makePlayerBattleAction(gh.battleID, player, action);
+		}
+
+		if(!actionAccepted && !gh.result)
+		{
+			logGlobal->warn("%s did not provide valid action, using fallback action", scenario.getAIName(actingSide));
+			gh.battles->makePlayerBattleAction(gh.battleID, player, *fallbackAction);
+		}
+	}
+
+	battleTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - battleStart);
+
+	if(!gh.result)
+		return outcome;
+
+	outcome.finished = true;
+	outcome.winner = gh.result->winner;
+	outcome.rounds = gh.rounds;
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+		for(const auto & casualty : gh.result->casualties[side])
+			outcome.casualties[side] += casualty.second;
+
+	return outcome;
+}
+
+void BattleSimulator::run(int battlesCount, std::optional<int> seed)
+{
+	auto runStart = std::chrono::steady_clock::now();
+
+	for(int i = 0; i < battlesCount; ++i)
+	{
+		std::optional<int> battleSeed;
+		if(seed)
+			battleSeed = *seed + i;
+
+		BattleOutcome outcome = simulateBattle(battleSeed);
+		++battles;
+
+		if(!outcome.finished)
+		{
+			logGlobal->error("Battle %d was aborted", i);
+			++abortedBattles;
+			continue;
+		}
+
+		totalRounds += outcome.rounds;
+		if(outcome.winner == BattleSide::NONE)
+			++draws;
+		else
+			++sides[outcome.winner].victories;
+
+		for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+			sides[side].casualties += outcome.casualties[side];
+
+		logGlobal->debug("Battle %d finished after %d rounds, winner: %d", i, outcome.rounds, static_cast<int>(outcome.winner));
+	}
+
+	totalTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - runStart);
+}
+
+JsonNode BattleSimulator::getReport() const
+{
+	JsonNode report;
+	uint64_t finishedBattles = battles - abortedBattles;
+
+	report["battles"].Integer() = battles;
+	report["aborted"].Integer() = abortedBattles;
+	report["draws"].Integer() = draws;
+	report["averageRounds"].Float() = finishedBattles ? static_cast<double>(totalRounds) / finishedBattles : 0.0;
+	report["totalTimeMs"].Integer() = totalTime.count() / 1000;
+	report["battleTimeMs"].Integer() = battleTime.count() / 1000;
+	report["battlesPerSecond"].Float() = totalTime.count() ? battles * 1000000.0 / totalTime.count() : 0.0;
+
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+	{
+		JsonNode & sideReport = report[side == BattleSide::ATTACKER ? "attacker" : "defender"];
+		sideReport["ai"].String() = scenario.getAIName(side);
+		sideReport["victories"].Integer() = sides[side].victories;
+		sideReport["averageCasualties"].Float() = finishedBattles ? static_cast<double>(sides[side].casualties) / finishedBattles : 0.0;
+		describeDecisionTimes(sideReport["decisionTimes"], sides[side].decisionTimes);
+	}
+	return report;
+}
+
+void BattleSimulator::printReport(std::ostream & stream) const
+{
+	JsonNode report = getReport();
+
+	stream << boost::format("Battles: %d (aborted: %d), draws: %d, average rounds: %.2f\n")
+		% report["battles"].Integer()
+		% report["aborted"].Integer()
+		% report["draws"].Integer()
+		% report["averageRounds"].Float();
+
+	stream << boost::format("Total time: %d ms, in battles: %d ms, battles per second: %.2f\n")
+		% report["totalTimeMs"].Integer()
+		% report["battleTimeMs"].Integer()
+		% report["battlesPerSecond"].Float();
+
+	for(const auto * sideName : {"attacker", "defender"})
+	{
+		const JsonNode & side = report[sideName];
+		const JsonNode & times = side["decisionTimes"];
+
+		stream << boost::format("%s (%s): %d victories, average casualties: %.2f\n")
+			% sideName
+			% side["ai"].String()
+			% side["victories"].Integer()
+			% side["averageCasualties"].Float();
+
+		stream << boost::format("\tdecisions: %d, latency us: avg %d, p50 %d, p90 %d, p99 %d, max %d\n")
+			% times["decisions"].Integer()
+			% times["averageUs"].Integer()
+			% times["p50Us"].Integer()
+			% times["p90Us"].Integer()
+			% times["p99Us"].Integer()
+			% times["maxUs"].Integer();
+	}
+}
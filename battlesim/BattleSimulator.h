@@ -0,0 +1,68 @@
+/*
+ * BattleSimulator.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/SampledStatistics.h"
+#include "../lib/battle/BattleSide.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+class BattleScenario;
+class CVCMIServer;
+
+/// Plays series of battles of the same scenario between battle AI's using server-side battle processing.
+/// Every battle is fought in separate AI-only game created for this battle, without client and adventure map AI
+class BattleSimulator
+{
+	/// Number of decision times of each side kept to estimate percentiles,
+	/// so memory usage does not depend on number of simulated battles
+	static constexpr size_t DECISION_SAMPLE_SIZE = 65536;
+
+	struct SideStatistics
+	{
+		uint64_t victories = 0;
+		uint64_t casualties = 0;
+		SampledStatistics decisionTimes{DECISION_SAMPLE_SIZE};
+	};
+
+	/// Result of single simulated battle
+	struct BattleOutcome
+	{
+		bool finished = false;
+		BattleSide winner = BattleSide::NONE;
+		int rounds = 0;
+		BattleSideArray<uint64_t> casualties = {0, 0};
+	};
+
+	const BattleScenario & scenario;
+	std::unique_ptr<CVCMIServer> server;
+
+	BattleSideArray<SideStatistics> sides;
+	uint64_t battles = 0;
+	uint64_t abortedBattles = 0;
+	uint64_t draws = 0;
+	uint64_t totalRounds = 0;
+	std::chrono::microseconds totalTime{0};
+	std::chrono::microseconds battleTime{0};
+
+	BattleOutcome simulateBattle(std::optional<int> seed);
+
+public:
+	explicit BattleSimulator(const BattleScenario & scenario);
+	~BattleSimulator();
+
+	/// Simulates specified number of battles. If seed is set, battle N is played using seed + N
+	void run(int battlesCount, std::optional<int> seed);
+
+	JsonNode getReport() const;
+	void printReport(std::ostream & stream) const;
+};
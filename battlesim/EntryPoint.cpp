@@ -0,0 +1,129 @@
+/*
+ * EntryPoint.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "BattleScenario.h"
+#include "BattleSimulator.h"
+
+#include "../lib/CConsoleHandler.h"
+#include "../lib/VCMIDirs.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/logging/CBasicLogConfigurator.h"
+#include "../lib/logging/CLogger.h"
+
+#include <boost/program_options.hpp>
+
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("scenario", boost::program_options::value<std::string>(), "json file with description of armies taking part in battle")
+	("battles", boost::program_options::value<int>()->default_value(100), "number of battles to simulate")
+	("seed", boost::program_options::value<int>(), "random seed of first battle, following battles use consecutive seeds")
+	("attacker-ai", boost::program_options::value<std::string>(), "battle AI of attacker, overrides value from scenario")
+	("defender-ai", boost::program_options::value<std::string>(), "battle AI of defender, overrides value from scenario")
+	("output", boost::program_options::value<std::string>(), "write simulation report to specified json file")
+	("verbose", "do not suppress log messages below warning level");
+
+	try
+	{
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), options);
+		boost::program_options::notify(options);
+	}
+	catch(boost::program_options::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+		exit(1);
+	}
+
+	if(options.count("help") || !options.count("scenario"))
+	{
+		printf("%s - battle AI simulator\n", GameConstants::VCMI_VERSION.c_str());
+		printf("Usage: vcmibattlesim --scenario <file> [options]\n");
+		std::cout << opts;
+		exit(options.count("help") ? 0 : 1);
+	}
+}
+
+static JsonNode loadScenario(const boost::filesystem::path & filename)
+{
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	if(!file)
+		throw std::runtime_error("Failed to open scenario file " + filename.string());
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return JsonNode(reinterpret_cast<const std::byte *>(data.data()), data.size(), filename.string());
+}
+
+int main(int argc, const char * argv[])
+{
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+
+	// file names given on command line are relative to working dir of caller
+	const boost::filesystem::path scenarioPath = boost::filesystem::absolute(opts["scenario"].as<std::string>());
+	std::optional<boost::filesystem::path> outputPath;
+	if(opts.count("output"))
+		outputPath = boost::filesystem::absolute(opts["output"].as<std::string>());
+
+	// Correct working dir executable folder (not bundle folder) so we can use executable relative paths
+	boost::filesystem::current_path(boost::filesystem::system_complete(argv[0]).parent_path());
+
+	console = new CConsoleHandler();
+	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_BattleSim_log.txt", console);
+	logConfig.configureDefault();
+	preinitDLL(console, false);
+	logConfig.configure();
+
+	// per-battle messages of game handler and AI would dominate both output and measured time
+	if(!opts.count("verbose"))
+		CLogger::getGlobalLogger()->setLevel(ELogLevel::WARN);
+
+	loadDLLClasses();
+
+	int exitCode = 0;
+	try
+	{
+		BattleScenario scenario(loadScenario(scenarioPath));
+
+		if(opts.count("attacker-ai"))
+			scenario.setAIName(BattleSide::ATTACKER, opts["attacker-ai"].as<std::string>());
+		if(opts.count("defender-ai"))
+			scenario.setAIName(BattleSide::DEFENDER, opts["defender-ai"].as<std::string>());
+
+		std::optional<int> seed;
+		if(opts.count("seed"))
+			seed = opts["seed"].as<int>();
+
+		BattleSimulator simulator(scenario);
+		simulator.run(opts["battles"].as<int>(), seed);
+		simulator.printReport(std::cout);
+
+		if(outputPath)
+		{
+			std::ofstream output(outputPath->c_str());
+			if(!output)
+				throw std::runtime_error("Failed to open output file " + outputPath->string());
+			output << simulator.getReport().toString();
+		}
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Battle simulation failed: %s", e.what());
+		exitCode = 1;
+	}
+
+	logConfig.deconfigure();
+	vstd::clear_pointer(VLC);
+
+	return exitCode;
+}
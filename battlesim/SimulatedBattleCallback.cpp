@@ -0,0 +1,105 @@
+/*
+ * SimulatedBattleCallback.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "SimulatedBattleCallback.h"
+
+#include "../server/CGameHandler.h"
+
+#include "../lib/VCMI_Lib.h"
+#include "../lib/battle/CPlayerBattleCallback.h"
+#include "../lib/battle/IBattleState.h"
+
+SimulatedBattleCallback::SimulatedBattleCallback(PlayerColor player)
+	: player(player)
+{
+}
+
+void SimulatedBattleCallback::battleMakeSpellAction(const BattleID & battleID, const BattleAction & action)
+{
+	assert(action.actionType == EActionType::HERO_SPELL);
+	pendingActions.push_back(action);
+}
+
+void SimulatedBattleCallback::battleMakeUnitAction(const BattleID & battleID, const BattleAction & action)
+{
+	pendingActions.push_back(action);
+}
+
+void SimulatedBattleCallback::battleMakeTacticAction(const BattleID & battleID, const BattleAction & action)
+{
+	pendingActions.push_back(action);
+}
+
+std::optional<BattleAction> SimulatedBattleCallback::makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
+{
+	// simulated battles are always fought until the end
+	return std::nullopt;
+}
+
+std::shared_ptr<CPlayerBattleCallback> SimulatedBattleCallback::getBattle(const BattleID & battleID)
+{
+	if (activeBattles.count(battleID))
+		return activeBattles.at(battleID);
+
+	throw std::runtime_error("Failed to find battle " + std::to_string(battleID.getNum()) + " of player " + player.toString());
+}
+
+std::optional<PlayerColor> SimulatedBattleCallback::getPlayerID() const
+{
+	return player;
+}
+
+void SimulatedBattleCallback::onBattleStarted(const IBattleInfo * info)
+{
+	activeBattles[info->getBattleID()] = std::make_shared<CPlayerBattleCallback>(info, player);
+}
+
+void SimulatedBattleCallback::onBattleEnded(const BattleID & battleID)
+{
+	activeBattles.erase(battleID);
+}
+
+std::vector<BattleAction> SimulatedBattleCallback::takePendingActions()
+{
+	std::vector<BattleAction> result;
+	std::swap(result, pendingActions);
+	return result;
+}
+
+SimulatedEnvironment::SimulatedEnvironment(CGameHandler * gameHandler, std::shared_ptr<SimulatedBattleCallback> callback)
+	: gameHandler(gameHandler)
+	, callback(callback)
+{
+}
+
+const Services * SimulatedEnvironment::services() const
+{
+	return VLC;
+}
+
+const SimulatedEnvironment::BattleCb * SimulatedEnvironment::battle(const BattleID & battleID) const
+{
+	return callback->getBattle(battleID).get();
+}
+
+const SimulatedEnvironment::GameCb * SimulatedEnvironment::game() const
+{
+	return gameHandler;
+}
+
+vstd::CLoggerBase * SimulatedEnvironment::logger() const
+{
+	return logAi;
+}
+
+events::EventBus * SimulatedEnvironment::eventBus() const
+{
+	return gameHandler->eventBus();
+}
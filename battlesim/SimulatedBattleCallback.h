@@ -0,0 +1,60 @@
+/*
+ * SimulatedBattleCallback.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include <vcmi/Environment.h>
+
+#include "../CCallback.h"
+#include "../lib/battle/BattleAction.h"
+
+class CGameHandler;
+
+/// Battle callback given to battle AI in simulator.
+/// Actions requested by AI are only stored and later submitted to battle processor by simulator,
+/// so AI never observes battle state changing while it is still making its decision
+class SimulatedBattleCallback : public IBattleCallback
+{
+	PlayerColor player;
+	std::map<BattleID, std::shared_ptr<CPlayerBattleCallback>> activeBattles;
+	std::vector<BattleAction> pendingActions;
+
+public:
+	explicit SimulatedBattleCallback(PlayerColor player);
+
+	void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) override;
+	void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) override;
+	void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) override;
+	std::optional<BattleAction> makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState) override;
+
+	std::shared_ptr<CPlayerBattleCallback> getBattle(const BattleID & battleID) override;
+	std::optional<PlayerColor> getPlayerID() const override;
+
+	void onBattleStarted(const IBattleInfo * info);
+	void onBattleEnded(const BattleID & battleID);
+
+	/// Returns all actions requested by AI since last call
+	std::vector<BattleAction> takePendingActions();
+};
+
+/// Environment of battle AI in simulator, gives AI direct access to game state of simulated game
+class SimulatedEnvironment : public Environment
+{
+	CGameHandler * gameHandler;
+	std::shared_ptr<SimulatedBattleCallback> callback;
+
+public:
+	SimulatedEnvironment(CGameHandler * gameHandler, std::shared_ptr<SimulatedBattleCallback> callback);
+
+	const Services * services() const override;
+	const BattleCb * battle(const BattleID & battleID) const override;
+	const GameCb * game() const override;
+	vstd::CLoggerBase * logger() const override;
+	events::EventBus * eventBus() const override;
+};
@@ -33,6 +33,7 @@
 #include "../lib/serializer/Connection.h"
 #include "../lib/mapping/CMapService.h"
 #include "../lib/pathfinder/CGPathNode.h"
+#include "../lib/pathfinder/PathfinderOptions.h"
 #include "../lib/filesystem/Filesystem.h"
 
 #include <memory>
@@ -224,6 +225,7 @@ void CClient::initMapHandler()
 	}
 
 	pathCache.clear();
+	pathStoragePool.clear();
 }
 
 void CClient::initPlayerEnvironments()
@@ -368,7 +370,8 @@ void CClient::handlePack(CPackForClient * pack)
 
 int CClient::sendRequest(const CPackForServer * request, PlayerColor player)
 {
-	static ui32 requestCounter = 1;
+	// several AI players may send requests from their own threads at the same time
+	static std::atomic<ui32> requestCounter = 1;
 
 	ui32 requestID = requestCounter++;
 	logNetwork->trace("Sending a request \"%s\". It'll have an ID=%d.", typeid(*request).name(), requestID);
@@ -377,8 +380,9 @@ int CClient::sendRequest(const CPackForServer * request, PlayerColor player)
 	request->requestID = requestID;
 	request->player = player;
 	CSH->logicConnection->sendPack(request);
-	if(vstd::contains(playerint, player))
-		playerint[player]->requestSent(request, requestID);
+	auto playerInterface = playerint.find(player);
+	if(playerInterface != playerint.end())
+		playerInterface->second->requestSent(request, requestID);
 
 	return requestID;
 }
@@ -512,9 +516,31 @@ void CClient::updatePath(const CGHeroInstance * hero)
 void CClient::invalidatePaths()
 {
 	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
+	for(auto & entry : pathCache)
+	{
+		// paths that are still held by callers can't be reused
+		if(entry.second.use_count() == 1)
+			pathStoragePool.push_back(std::move(entry.second));
+	}
 	pathCache.clear();
 }
 
+std::shared_ptr<CPathsInfo> CClient::acquirePathStorage(const CGHeroInstance * h)
+{
+	while(!pathStoragePool.empty())
+	{
+		auto storage = std::move(pathStoragePool.back());
+		pathStoragePool.pop_back();
+
+		if(storage->sizes == getMapSize())
+		{
+			storage->reset(h);
+			return storage;
+		}
+	}
+	return std::make_shared<CPathsInfo>(getMapSize(), h);
+}
+
 vstd::RNG & CClient::getRandomGenerator()
 {
 	// Client should use CRandomGenerator::getDefault() for UI logic
@@ -531,7 +557,7 @@ std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h
 
 	if(iter == std::end(pathCache))
 	{
-		auto paths = std::make_shared<CPathsInfo>(getMapSize(), h);
+		auto paths = acquirePathStorage(h);
 
 		gs->calculatePaths(h, *paths.get());
 
@@ -544,6 +570,24 @@ std::shared_ptr<const CPathsInfo> CClient::getPathsInfo(const CGHeroInstance * h
 	}
 }
 
+void CClient::precalculatePaths(const std::vector<const CGHeroInstance *> & heroes)
+{
+	boost::unique_lock<boost::mutex> pathLock(pathCacheMutex);
+
+	std::vector<std::shared_ptr<PathfinderConfig>> configs;
+	for(const auto * h : heroes)
+	{
+		if(pathCache.count(h))
+			continue;
+
+		auto paths = acquirePathStorage(h);
+		configs.push_back(std::make_shared<SingleHeroPathfinderConfig>(*paths, gs, h));
+		pathCache[h] = paths;
+	}
+
+	gs->calculatePaths(configs);
+}
+
 #if SCRIPTING_ENABLED
 scripting::Pool * CClient::getGlobalContextPool() const
 {
@@ -154,6 +154,8 @@ public:
 	void updatePath(const ObjectInstanceID & heroID); // invalidatePaths and update displayed hero path 
 	void updatePath(const CGHeroInstance * hero);
 	std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
+	/// Calculates paths of all specified heroes in parallel and stores them in path cache
+	void precalculatePaths(const std::vector<const CGHeroInstance *> & heroes);
 
 	friend class CCallback; //handling players actions
 	friend class CBattleCallback; //handling players actions
@@ -237,6 +239,10 @@ private:
 
 	mutable boost::mutex pathCacheMutex;
 	std::map<const CGHeroInstance *, std::shared_ptr<CPathsInfo>> pathCache;
+	/// Node storages from invalidated paths that are no longer referenced and can be reused
+	std::vector<std::shared_ptr<CPathsInfo>> pathStoragePool;
+
+	std::shared_ptr<CPathsInfo> acquirePathStorage(const CGHeroInstance * h);
 
 	void reinitScripting();
 };
@@ -38,6 +38,7 @@
 #include "../lib/modding/ModUtility.h"
 #include "../lib/CHeroHandler.h"
 #include "../lib/VCMIDirs.h"
+#include "../lib/TraceProfiler.h"
 #include "../lib/logging/VisualLogger.h"
 #include "../lib/serializer/Connection.h"
 
@@ -508,6 +509,39 @@ void ClientCommandManager::handleGenerateAssets()
 	printCommandMessage("All assets generated");
 }
 
+void ClientCommandManager::handleProfilerCommand(std::istringstream & singleWordBuffer)
+{
+	std::string action;
+	singleWordBuffer >> action;
+
+	if(action == "start")
+	{
+		TraceProfiler::get().start();
+		printCommandMessage("Profiler started", ELogLevel::INFO);
+	}
+	else if(action == "stop")
+	{
+		TraceProfiler::get().stop();
+		printCommandMessage("Profiler stopped", ELogLevel::INFO);
+	}
+	else if(action == "dump")
+	{
+		try
+		{
+			std::string path = TraceProfiler::get().dump();
+			printCommandMessage("Profiler data saved to " + path, ELogLevel::INFO);
+		}
+		catch(const std::exception & e)
+		{
+			printCommandMessage("Failed to save profiler data: " + std::string(e.what()), ELogLevel::ERROR);
+		}
+	}
+	else
+	{
+		printCommandMessage("Usage: profiler start|stop|dump", ELogLevel::ERROR);
+	}
+}
+
 void ClientCommandManager::printCommandMessage(const std::string &commandMessage, ELogLevel::ELogLevel messageType)
 {
 	switch(messageType)
@@ -633,6 +667,9 @@ void ClientCommandManager::processCommand(const std::string & message, bool call
 	else if(message=="generate assets")
 		handleGenerateAssets();
 
+	else if(commandName == "profiler")
+		handleProfilerCommand(singleWordBuffer);
+
 	else
 	{
 		if (!commandName.empty() && !vstd::iswithin(commandName[0], 0, ' ')) // filter-out debugger/IDE noise
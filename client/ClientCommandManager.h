@@ -87,6 +87,9 @@ class ClientCommandManager //take mantis #2292 issue about account if thinking a
 	// generate all assets
 	void handleGenerateAssets();
 
+	// Controls trace profiler: start / stop recording or dump collected data to file
+	void handleProfilerCommand(std::istringstream & singleWordBuffer);
+
 	// Prints in Chat the given message
 	void printCommandMessage(const std::string &commandMessage, ELogLevel::ELogLevel messageType = ELogLevel::NOT_SET);
 	void giveTurn(const PlayerColor &color);
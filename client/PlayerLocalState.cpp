@@ -38,6 +38,11 @@ void PlayerLocalState::loadHeroPaths(std::map<const CGHeroInstance *, int3> & pa
 {
 	if(owner.cb)
 	{
+		std::vector<const CGHeroInstance *> heroes;
+		for(auto & p : pathsMap)
+			heroes.push_back(p.first);
+		owner.cb->precalculatePaths(heroes);
+
 		for(auto & p : pathsMap)
 		{
 			CGPath path;
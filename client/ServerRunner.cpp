@@ -11,6 +11,7 @@
 
 #include "ServerRunner.h"
 
+#include "../lib/CConfigHandler.h"
 #include "../lib/VCMIDirs.h"
 #include "../lib/CThreadHelper.h"
 #include "../server/CVCMIServer.h"
@@ -104,6 +105,13 @@ uint16_t ServerProcessRunner::start(uint16_t port, bool connectToLobby, std::sha
 	if(connectToLobby)
 		args.push_back("--lobby");
 
+	const JsonNode & benchmark = settings["session"]["benchmark"];
+	if(!benchmark["output"].String().empty())
+	{
+		args.push_back("--benchmark-output=" + benchmark["output"].String());
+		args.push_back("--benchmark-days=" + std::to_string(benchmark["days"].Integer()));
+	}
+
 	std::error_code ec;
 	child = std::make_unique<boost::process::child>(serverPath, args, ec, boost::process::std_out > logPath);
 
@@ -272,6 +272,8 @@ void AdventureMapShortcuts::endTurn()
 
 	if(settings["adventure"]["heroReminder"].Bool())
 	{
+		LOCPLINT->cb->precalculatePaths(LOCPLINT->localState->getWanderingHeroes());
+
 		for(auto hero : LOCPLINT->localState->getWanderingHeroes())
 		{
 			if(!LOCPLINT->localState->isHeroSleeping(hero) && hero->movementPointsRemaining() > 0)
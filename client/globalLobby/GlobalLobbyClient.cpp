@@ -66,6 +66,12 @@ void GlobalLobbyClient::onPacketReceived(const std::shared_ptr<INetworkConnectio
 	if(json["type"].String() == "activeGameRooms")
 		return receiveActiveGameRooms(json);
 
+	if(json["type"].String() == "activeAccountsUpdate")
+		return receiveActiveAccountsUpdate(json);
+
+	if(json["type"].String() == "activeGameRoomsUpdate")
+		return receiveActiveGameRoomsUpdate(json);
+
 	if(json["type"].String() == "joinRoomSuccess")
 		return receiveJoinRoomSuccess(json);
 
@@ -176,21 +182,91 @@ void GlobalLobbyClient::receiveChatMessage(const JsonNode & json)
 	}
 }
 
+static GlobalLobbyAccount loadActiveAccount(const JsonNode & jsonEntry)
+{
+	GlobalLobbyAccount account;
+
+	account.accountID = jsonEntry["accountID"].String();
+	account.displayName = jsonEntry["displayName"].String();
+	account.status = jsonEntry["status"].String();
+
+	return account;
+}
+
+static GlobalLobbyRoom loadActiveGameRoom(const JsonNode & jsonEntry)
+{
+	GlobalLobbyRoom room;
+
+	room.gameRoomID = jsonEntry["gameRoomID"].String();
+	room.hostAccountID = jsonEntry["hostAccountID"].String();
+	room.hostAccountDisplayName = jsonEntry["hostAccountDisplayName"].String();
+	room.description = jsonEntry["description"].String();
+	room.statusID = jsonEntry["status"].String();
+	room.gameVersion = jsonEntry["version"].String();
+	room.modList = ModVerificationInfo::jsonDeserializeList(jsonEntry["mods"]);
+	std::chrono::seconds ageSeconds (jsonEntry["ageSeconds"].Integer());
+	room.startDateFormatted = TextOperations::getCurrentFormattedDateTimeLocal(-ageSeconds);
+
+	for(const auto & jsonParticipant : jsonEntry["participants"].Vector())
+	{
+		GlobalLobbyAccount account;
+		account.accountID =  jsonParticipant["accountID"].String();
+		account.displayName =  jsonParticipant["displayName"].String();
+		room.participants.push_back(account);
+	}
+
+	for(const auto & jsonParticipant : jsonEntry["invited"].Vector())
+	{
+		GlobalLobbyAccount account;
+		account.accountID =  jsonParticipant["accountID"].String();
+		account.displayName =  jsonParticipant["displayName"].String();
+		room.invited.push_back(account);
+	}
+
+	room.playerLimit = jsonEntry["playerLimit"].Integer();
+
+	return room;
+}
+
 void GlobalLobbyClient::receiveActiveAccounts(const JsonNode & json)
 {
 	activeAccounts.clear();
 
 	for(const auto & jsonEntry : json["accounts"].Vector())
+		activeAccounts.push_back(loadActiveAccount(jsonEntry));
+
+	onActiveAccountsChanged();
+}
+
+void GlobalLobbyClient::receiveActiveAccountsUpdate(const JsonNode & json)
+{
+	for(const auto & jsonEntry : json["left"].Vector())
 	{
-		GlobalLobbyAccount account;
+		vstd::erase_if(activeAccounts, [&jsonEntry](const GlobalLobbyAccount & account)
+		{
+			return account.accountID == jsonEntry.String();
+		});
+	}
 
-		account.accountID = jsonEntry["accountID"].String();
-		account.displayName = jsonEntry["displayName"].String();
-		account.status = jsonEntry["status"].String();
+	for(const auto & jsonEntry : json["joined"].Vector())
+	{
+		auto account = loadActiveAccount(jsonEntry);
+		auto existing = boost::find_if(activeAccounts, [&account](const GlobalLobbyAccount & entry)
+		{
+			return entry.accountID == account.accountID;
+		});
 
-		activeAccounts.push_back(account);
+		if(existing != activeAccounts.end())
+			*existing = account;
+		else
+			activeAccounts.push_back(account);
 	}
 
+	onActiveAccountsChanged();
+}
+
+void GlobalLobbyClient::onActiveAccountsChanged()
+{
 	auto lobbyWindowPtr = lobbyWindow.lock();
 	if(lobbyWindowPtr)
 		lobbyWindowPtr->onActiveAccounts(activeAccounts);
@@ -204,40 +280,40 @@ void GlobalLobbyClient::receiveActiveGameRooms(const JsonNode & json)
 	activeRooms.clear();
 
 	for(const auto & jsonEntry : json["gameRooms"].Vector())
-	{
-		GlobalLobbyRoom room;
+		activeRooms.push_back(loadActiveGameRoom(jsonEntry));
 
-		room.gameRoomID = jsonEntry["gameRoomID"].String();
-		room.hostAccountID = jsonEntry["hostAccountID"].String();
-		room.hostAccountDisplayName = jsonEntry["hostAccountDisplayName"].String();
-		room.description = jsonEntry["description"].String();
-		room.statusID = jsonEntry["status"].String();
-		room.gameVersion = jsonEntry["version"].String();
-		room.modList = ModVerificationInfo::jsonDeserializeList(jsonEntry["mods"]);
-		std::chrono::seconds ageSeconds (jsonEntry["ageSeconds"].Integer());
-		room.startDateFormatted = TextOperations::getCurrentFormattedDateTimeLocal(-ageSeconds);
+	onActiveGameRoomsChanged();
+}
 
-		for(const auto & jsonParticipant : jsonEntry["participants"].Vector())
+void GlobalLobbyClient::receiveActiveGameRoomsUpdate(const JsonNode & json)
+{
+	for(const auto & jsonEntry : json["removed"].Vector())
+	{
+		vstd::erase_if(activeRooms, [&jsonEntry](const GlobalLobbyRoom & room)
 		{
-			GlobalLobbyAccount account;
-			account.accountID =  jsonParticipant["accountID"].String();
-			account.displayName =  jsonParticipant["displayName"].String();
-			room.participants.push_back(account);
-		}
+			return room.gameRoomID == jsonEntry.String();
+		});
+	}
 
-		for(const auto & jsonParticipant : jsonEntry["invited"].Vector())
+	for(const auto & jsonEntry : json["changed"].Vector())
+	{
+		auto room = loadActiveGameRoom(jsonEntry);
+		auto existing = boost::find_if(activeRooms, [&room](const GlobalLobbyRoom & entry)
 		{
-			GlobalLobbyAccount account;
-			account.accountID =  jsonParticipant["accountID"].String();
-			account.displayName =  jsonParticipant["displayName"].String();
-			room.invited.push_back(account);
-		}
-
-		room.playerLimit = jsonEntry["playerLimit"].Integer();
+			return entry.gameRoomID == room.gameRoomID;
+		});
 
-		activeRooms.push_back(room);
+		if(existing != activeRooms.end())
+			*existing = room;
+		else
+			activeRooms.push_back(room);
 	}
 
+	onActiveGameRoomsChanged();
+}
+
+void GlobalLobbyClient::onActiveGameRoomsChanged()
+{
 	auto lobbyWindowPtr = lobbyWindow.lock();
 	if(lobbyWindowPtr)
 		lobbyWindowPtr->onActiveGameRooms(activeRooms);
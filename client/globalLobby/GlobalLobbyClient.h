@@ -51,7 +51,11 @@ class GlobalLobbyClient final : public INetworkClientListener, boost::noncopyabl
 	void receiveChatHistory(const JsonNode & json);
 	void receiveChatMessage(const JsonNode & json);
 	void receiveActiveAccounts(const JsonNode & json);
+	void receiveActiveAccountsUpdate(const JsonNode & json);
 	void receiveActiveGameRooms(const JsonNode & json);
+	void receiveActiveGameRoomsUpdate(const JsonNode & json);
+	void onActiveAccountsChanged();
+	void onActiveGameRoomsChanged();
 	void receiveMatchesHistory(const JsonNode & json);
 	void receiveJoinRoomSuccess(const JsonNode & json);
 	void receiveInviteReceived(const JsonNode & json);
@@ -0,0 +1,171 @@
+/*
+ * MapHeaderIndex.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "MapHeaderIndex.h"
+
+#include "SelectionTab.h"
+
+#include "../../lib/VCMIDirs.h"
+#include "../../lib/filesystem/Filesystem.h"
+#include "../../lib/mapping/CMapHeader.h"
+#include "../../lib/serializer/CLoadFile.h"
+#include "../../lib/serializer/CSaveFile.h"
+
+static const std::string indexMagic = "VCMIMAPINDEX";
+
+MapHeaderIndex::MapHeaderIndex()
+{
+	const auto indexPath = getIndexPath();
+	if(!boost::filesystem::exists(indexPath))
+		return;
+
+	try
+	{
+		// index written by different version of the game is rejected by CLoadFile and will be rebuilt
+		CLoadFile file(indexPath);
+		file.checkMagicBytes(indexMagic);
+
+		uint32_t entriesCount = 0;
+		file >> entriesCount;
+
+		for(uint32_t i = 0; i < entriesCount; ++i)
+		{
+			std::string fileURI;
+			Entry entry;
+			entry.header = std::make_unique<CMapHeader>();
+
+			file >> fileURI >> entry.stamp.size >> entry.stamp.lastWriteTime >> *entry.header;
+			entries[fileURI] = std::move(entry);
+		}
+		logGlobal->debug("Loaded index of %d map headers", entries.size());
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to load map header index: %s", e.what());
+		entries.clear();
+	}
+}
+
+MapHeaderIndex::~MapHeaderIndex() = default;
+
+boost::filesystem::path MapHeaderIndex::getIndexPath()
+{
+	return VCMIDirs::get().userCachePath() / "mapHeaders.vindex";
+}
+
+std::optional<MapHeaderIndex::FileStamp> MapHeaderIndex::getFileStamp(const std::string & fileURI)
+{
+	auto path = CResourceHandler::get()->getResourceName(ResourcePath(fileURI, EResType::MAP));
+	if(!path)
+		return std::nullopt;
+
+	boost::system::error_code ec;
+	FileStamp stamp;
+	stamp.size = boost::filesystem::file_size(*path, ec);
+	if(ec)
+		return std::nullopt;
+
+	stamp.lastWriteTime = boost::filesystem::last_write_time(*path, ec);
+	if(ec)
+		return std::nullopt;
+
+	return stamp;
+}
+
+std::shared_ptr<ElementInfo> MapHeaderIndex::find(const ResourcePath & file)
+{
+	auto it = entries.find(file.getName());
+	if(it == entries.end() || !it->second.header)
+		return nullptr;
+
+	auto stamp = getFileStamp(file.getName());
+	if(!stamp || !(*stamp == it->second.stamp))
+		return nullptr;
+
+	try
+	{
+		auto mapInfo = std::make_shared<ElementInfo>();
+		mapInfo->mapInit(file.getName(), std::move(it->second.header));
+		usedEntries += 1;
+		return mapInfo;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to use indexed header of %s: %s", file.getName(), e.what());
+		return nullptr;
+	}
+}
+
+std::vector<std::shared_ptr<ElementInfo>> MapHeaderIndex::parseMaps(const std::vector<ResourcePath> & files)
+{
+	std::vector<std::shared_ptr<ElementInfo>> parsedMaps(files.size());
+	std::atomic<size_t> nextFile = 0;
+
+	const auto & parseFiles = [&]()
+	{
+		for(size_t i = nextFile++; i < files.size(); i = nextFile++)
+		{
+			try
+			{
+				auto mapInfo = std::make_shared<ElementInfo>();
+				mapInfo->mapInit(files[i].getName());
+				parsedMaps[i] = mapInfo;
+			}
+			catch(const std::exception & e)
+			{
+				logGlobal->error("Map %s is invalid. Message: %s", files[i].getName(), e.what());
+			}
+		}
+	};
+
+	size_t threadsCount = std::min<size_t>(files.size(), std::max(1u, boost::thread::hardware_concurrency()));
+	std::vector<boost::thread> threads;
+	for(size_t i = 1; i < threadsCount; ++i)
+		threads.emplace_back(parseFiles);
+
+	parseFiles();
+
+	for(auto & thread : threads)
+		thread.join();
+
+	vstd::erase(parsedMaps, nullptr);
+	return parsedMaps;
+}
+
+void MapHeaderIndex::update(const std::vector<std::shared_ptr<ElementInfo>> & maps)
+{
+	if(usedEntries == maps.size() && usedEntries == entries.size())
+		return;
+
+	try
+	{
+		CSaveFile file(getIndexPath());
+		file.putMagicBytes(indexMagic);
+
+		std::vector<std::pair<std::shared_ptr<ElementInfo>, FileStamp>> indexedMaps;
+		for(const auto & map : maps)
+		{
+			auto stamp = getFileStamp(map->fileURI);
+			if(stamp && map->mapHeader)
+				indexedMaps.emplace_back(map, *stamp);
+		}
+
+		file << static_cast<uint32_t>(indexedMaps.size());
+		for(const auto & [map, stamp] : indexedMaps)
+			file << map->fileURI << stamp.size << stamp.lastWriteTime << *map->mapHeader;
+
+		file.writeToFile();
+		logGlobal->debug("Written index of %d map headers", indexedMaps.size());
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to write map header index: %s", e.what());
+	}
+}
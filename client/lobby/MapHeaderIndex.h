@@ -0,0 +1,59 @@
+/*
+ * MapHeaderIndex.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CMapHeader;
+class ResourcePath;
+VCMI_LIB_NAMESPACE_END
+
+class ElementInfo;
+
+/// Persistent index of map headers, stored in user cache directory
+/// Allows showing list of maps without parsing every map file. Only new or modified maps need to be parsed
+class MapHeaderIndex : boost::noncopyable
+{
+	struct FileStamp
+	{
+		int64_t size = 0;
+		int64_t lastWriteTime = 0;
+
+		bool operator==(const FileStamp & other) const
+		{
+			return size == other.size && lastWriteTime == other.lastWriteTime;
+		}
+	};
+
+	struct Entry
+	{
+		FileStamp stamp;
+		std::unique_ptr<CMapHeader> header;
+	};
+
+	std::map<std::string, Entry> entries;
+	size_t usedEntries = 0;
+
+	static boost::filesystem::path getIndexPath();
+	static std::optional<FileStamp> getFileStamp(const std::string & fileURI);
+
+public:
+	/// Loads index from disk. Missing, damaged or outdated index is discarded
+	MapHeaderIndex();
+	~MapHeaderIndex();
+
+	/// Returns map info created from indexed header if index contains entry for current version of the file, or nullptr otherwise
+	std::shared_ptr<ElementInfo> find(const ResourcePath & file);
+
+	/// Parses specified maps in parallel. Maps that could not be parsed are omitted from result
+	static std::vector<std::shared_ptr<ElementInfo>> parseMaps(const std::vector<ResourcePath> & files);
+
+	/// Writes index with specified maps to disk, unless it would be identical to index that was loaded
+	void update(const std::vector<std::shared_ptr<ElementInfo>> & maps);
+};
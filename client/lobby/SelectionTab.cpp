@@ -12,6 +12,7 @@
 #include "SelectionTab.h"
 #include "CSelectionBase.h"
 #include "CLobbyScreen.h"
+#include "MapHeaderIndex.h"
 
 #include "../CGameInfo.h"
 #include "../CPlayerInterface.h"
@@ -803,21 +804,27 @@ void SelectionTab::parseMaps(const std::unordered_set<ResourcePath> & files)
 {
 	logGlobal->debug("Parsing %d maps", files.size());
 	allItems.clear();
+
+	MapHeaderIndex index;
+	std::vector<std::shared_ptr<ElementInfo>> parsedMaps;
+	std::vector<ResourcePath> filesToParse;
+
 	for(auto & file : files)
 	{
-		try
-		{
-			auto mapInfo = std::make_shared<ElementInfo>();
-			mapInfo->mapInit(file.getName());
-
-			if (isMapSupported(*mapInfo))
-				allItems.push_back(mapInfo);
-		}
-		catch(std::exception & e)
-		{
-			logGlobal->error("Map %s is invalid. Message: %s", file.getName(), e.what());
-		}
+		auto mapInfo = index.find(file);
+		if(mapInfo)
+			parsedMaps.push_back(mapInfo);
+		else
+			filesToParse.push_back(file);
 	}
+
+	logGlobal->debug("Found %d maps in index, parsing remaining %d maps", parsedMaps.size(), filesToParse.size());
+	vstd::concatenate(parsedMaps, MapHeaderIndex::parseMaps(filesToParse));
+	index.update(parsedMaps);
+
+	for(auto & mapInfo : parsedMaps)
+		if (isMapSupported(*mapInfo))
+			allItems.push_back(mapInfo);
 }
 
 void SelectionTab::parseSaves(const std::unordered_set<ResourcePath> & files)
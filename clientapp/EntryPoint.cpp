@@ -144,6 +144,8 @@ int main(int argc, char * argv[])
 		("spectate-skip-battle-result", "skip battle result window")
 		("onlyAI", "allow one to run without human player, all players will be default AI")
 		("headless", "runs without GUI, implies --onlyAI")
+		("benchmark-output", po::value<std::string>(), "write per-turn timings and other game statistics to specified json file")
+		("benchmark-days", po::value<int>(), "end benchmarked game after specified number of days")
 		("ai", po::value<std::vector<std::string>>(), "AI to be used for the player, can be specified several times for the consecutive players")
 		("oneGoodAI", "puts one default AI and the rest will be EmptyAI")
 		("autoSkip", "automatically skip turns in GUI")
@@ -253,6 +255,13 @@ int main(int argc, char * argv[])
 		if(vm.count("spectate-battle-speed"))
 			session["spectate-battle-speed"].Float() = vm["spectate-battle-speed"].as<int>();
 	}
+	if(vm.count("benchmark-output"))
+	{
+		session["benchmark"]["output"].String() = vm["benchmark-output"].as<std::string>();
+		if(vm.count("benchmark-days"))
+			session["benchmark"]["days"].Integer() = vm["benchmark-days"].as<int>();
+	}
+
 	// Server settings
 	setSettingBool("session/donotstartserver", "donotstartserver");
 
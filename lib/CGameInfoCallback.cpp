@@ -298,7 +298,7 @@ std::vector<const CGObjectInstance*> CGameInfoCallback::getGuardingCreatures (in
 
 bool CGameInfoCallback::isTileGuardedUnchecked(int3 tile) const
 {
-	return !gs->guardingCreatures(tile).empty();
+	return !gs->map->getGuardingCreatures(tile).empty();
 }
 
 bool CGameInfoCallback::getHeroInfo(const CGObjectInstance * hero, InfoAboutHero & dest, const CGObjectInstance * selectedObject) const
@@ -557,16 +557,19 @@ std::shared_ptr<const boost::multi_array<TerrainTile*, 3>> CGameInfoCallback::ge
 
 	auto * ptr = new boost::multi_array<TerrainTile *, 3>(boost::extents[levels][width][height]);
 
-	int3 tile;
-	for(tile.z = 0; tile.z < levels; tile.z++)
-		for(tile.x = 0; tile.x < width; tile.x++)
-			for(tile.y = 0; tile.y < height; tile.y++)
-			{
-				if (team->fogOfWarMap[tile.z][tile.x][tile.y])
-					(*ptr)[tile.z][tile.x][tile.y] = &gs->map->getTile(tile);
-				else
-					(*ptr)[tile.z][tile.x][tile.y] = nullptr;
-			}
+	// map terrain, fog of war and result share [z][x][y] layout, so every column can be processed as contiguous block
+	for(size_t z = 0; z < levels; z++)
+	{
+		for(size_t x = 0; x < width; x++)
+		{
+			const ui8 * fowColumn = &team->fogOfWarMap[z][x][0];
+			TerrainTile ** resultColumn = &(*ptr)[z][x][0];
+			TerrainTile * tilesColumn = &gs->map->getTile(int3(x, 0, z));
+
+			for(size_t y = 0; y < height; y++)
+				resultColumn[y] = fowColumn[y] ? tilesColumn + y : nullptr;
+		}
+	}
 
 	return std::shared_ptr<const boost::multi_array<TerrainTile*, 3>>(ptr);
 }
@@ -944,6 +947,11 @@ void CGameInfoCallback::calculatePaths( const CGHeroInstance *hero, CPathsInfo &
 	gs->calculatePaths(hero, out);
 }
 
+void CGameInfoCallback::calculatePaths(const std::vector<std::shared_ptr<PathfinderConfig>> & configs)
+{
+	gs->calculatePaths(configs);
+}
+
 const CArtifactInstance * CGameInfoCallback::getArtInstance( ArtifactInstanceID aid ) const
 {
 	return gs->map->artInstances[aid.num];
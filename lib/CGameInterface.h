@@ -14,7 +14,7 @@
 
 #include "spells/ViewSpellInt.h"
 
-class CBattleCallback;
+class IBattleCallback;
 class CCallback;
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -74,8 +74,8 @@ public:
 	std::string dllName;
 
 	virtual ~CBattleGameInterface() {};
-	virtual void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB){};
-	virtual void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<CBattleCallback> CB, AutocombatPreferences autocombatPreferences){};
+	virtual void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB){};
+	virtual void initBattleInterface(std::shared_ptr<Environment> ENV, std::shared_ptr<IBattleCallback> CB, AutocombatPreferences autocombatPreferences){};
 
 	//battle call-ins
 	virtual void activeStack(const BattleID & battleID, const CStack * stack)=0; //called when it's turn of that stack
@@ -134,7 +134,7 @@ public:
 	CAdventureAI() = default;
 
 	std::shared_ptr<CBattleGameInterface> battleAI;
-	std::shared_ptr<CBattleCallback> cbc;
+	std::shared_ptr<IBattleCallback> cbc;
 
 	virtual std::string getBattleAIName() const = 0; //has to return name of the battle AI to be used
 
@@ -79,6 +79,34 @@ void CPrivilegedInfoCallback::getFreeTiles(std::vector<int3> & tiles) const
 	}
 }
 
+/// Returns shape of area within specified radius: for every column offset from 0 to radius
+/// contains largest row offset that is still in range, or -1 if column is outside of range
+static const std::vector<int> & getRangeProfile(int radius, int3::EDistanceFormula formula)
+{
+	static boost::mutex cacheMutex;
+	static std::map<std::pair<int, int3::EDistanceFormula>, std::vector<int>> cache;
+
+	boost::lock_guard<boost::mutex> lock(cacheMutex);
+	auto & profile = cache[{radius, formula}];
+	if(profile.empty())
+	{
+		const int3 center(0, 0, 0);
+		profile.resize(radius + 1, -1);
+		for(int dx = 0; dx <= radius; ++dx)
+		{
+			for(int dy = radius; dy >= 0; --dy)
+			{
+				if(center.dist(int3(dx, dy, 0), formula) <= radius)
+				{
+					profile[dx] = dy;
+					break;
+				}
+			}
+		}
+	}
+	return profile;
+}
+
 void CPrivilegedInfoCallback::getTilesInRange(std::unordered_set<int3> & tiles,
 											  const int3 & pos,
 											  int radious,
@@ -93,29 +121,52 @@ void CPrivilegedInfoCallback::getTilesInRange(std::unordered_set<int3> & tiles,
 	}
 	if(radious == CBuilding::HEIGHT_SKYSHIP) //reveal entire map
 		getAllTiles (tiles, player, -1, [](auto * tile){return true;});
-	else
+	else if(radious >= 0)
 	{
 		const TeamState * team = !player ? nullptr : gs->getPlayerTeam(*player);
+		const auto & profile = getRangeProfile(radious, distanceFormula);
 		for (int xd = std::max<int>(pos.x - radious , 0); xd <= std::min<int>(pos.x + radious, gs->map->width - 1); xd++)
 		{
-			for (int yd = std::max<int>(pos.y - radious, 0); yd <= std::min<int>(pos.y + radious, gs->map->height - 1); yd++)
+			int halfHeight = profile[std::abs(xd - pos.x)];
+			for (int yd = std::max<int>(pos.y - halfHeight, 0); yd <= std::min<int>(pos.y + halfHeight, gs->map->height - 1); yd++)
 			{
-				int3 tilePos(xd,yd,pos.z);
-				int distance = pos.dist(tilePos, distanceFormula);
-
-				if(distance <= radious)
-				{
-					if(!player
-						|| (mode == ETileVisibility::HIDDEN  && team->fogOfWarMap[pos.z][xd][yd] == 0)
-						|| (mode == ETileVisibility::REVEALED && team->fogOfWarMap[pos.z][xd][yd] == 1)
-					)
-						tiles.insert(int3(xd,yd,pos.z));
-				}
+				if(!player
+					|| (mode == ETileVisibility::HIDDEN  && team->fogOfWarMap[pos.z][xd][yd] == 0)
+					|| (mode == ETileVisibility::REVEALED && team->fogOfWarMap[pos.z][xd][yd] == 1)
+				)
+					tiles.insert(int3(xd,yd,pos.z));
 			}
 		}
 	}
 }
 
+void CPrivilegedInfoCallback::revealTilesInRange(boost::multi_array<ui8, 3> & fogOfWarMap, const int3 & pos, int radius, int3::EDistanceFormula formula) const
+{
+	if(radius == CBuilding::HEIGHT_SKYSHIP) //reveal entire map
+	{
+		std::fill(fogOfWarMap.data(), fogOfWarMap.data() + fogOfWarMap.num_elements(), 1);
+		return;
+	}
+
+	if(radius < 0)
+		return;
+
+	// fog of war is stored as [z][x][y], so every column of range area is a contiguous block of memory
+	const auto & profile = getRangeProfile(radius, formula);
+	for (int xd = std::max<int>(pos.x - radius, 0); xd <= std::min<int>(pos.x + radius, gs->map->width - 1); xd++)
+	{
+		int halfHeight = profile[std::abs(xd - pos.x)];
+		int yBegin = std::max<int>(pos.y - halfHeight, 0);
+		int yEnd = std::min<int>(pos.y + halfHeight, gs->map->height - 1);
+
+		if(yBegin <= yEnd)
+		{
+			ui8 * column = &fogOfWarMap[pos.z][xd][0];
+			std::fill(column + yBegin, column + yEnd + 1, 1);
+		}
+	}
+}
+
 void CPrivilegedInfoCallback::getAllTiles(std::unordered_set<int3> & tiles, std::optional<PlayerColor> Player, int level, std::function<bool(const TerrainTile *)> filter) const
 {
 	if(!!Player && !Player->isValidPlayer())
@@ -206,15 +257,20 @@ void CPrivilegedInfoCallback::saveCommonState(CSaveFile & out) const
 {
 	ActiveModsInSaveList activeMods;
 
+	// header and options are placed in separate leading sections so save browsing does not need to decompress entire game
 	logGlobal->info("Saving lib part of game...");
+	out.beginSection();
 	out.putMagicBytes(SAVEGAME_MAGIC);
 	logGlobal->info("\tSaving header");
 	out.serializer & static_cast<CMapHeader&>(*gs->map);
 	logGlobal->info("\tSaving options");
+	out.beginSection();
 	out.serializer & gs->scenarioOps;
 	logGlobal->info("\tSaving mod list");
+	out.beginSection();
 	out.serializer & activeMods;
 	logGlobal->info("\tSaving gamestate");
+	out.beginSection();
 	out.serializer & gs;
 }
 
@@ -71,6 +71,9 @@ public:
 						 std::optional<PlayerColor> player = std::optional<PlayerColor>(),
 						 int3::EDistanceFormula formula = int3::DIST_2D) const;
 
+	/// Marks all tiles within radius of pos as visible in provided fog of war map
+	void revealTilesInRange(boost::multi_array<ui8, 3> & fogOfWarMap, const int3 & pos, int radius, int3::EDistanceFormula formula = int3::DIST_2D) const;
+
 	//returns all tiles on given level (-1 - both levels, otherwise number of level)
 	void getAllTiles(std::unordered_set<int3> &tiles, std::optional<PlayerColor> player, int level, std::function<bool(const TerrainTile *)> filter) const;
 
@@ -0,0 +1,65 @@
+/*
+ * SampledStatistics.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "SampledStatistics.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+SampledStatistics::SampledStatistics(size_t sampleSize)
+	: sampleSize(sampleSize)
+{
+	assert(sampleSize > 0);
+}
+
+void SampledStatistics::add(int64_t value)
+{
+	count += 1;
+	total += value;
+	vstd::amax(maximum, value);
+
+	if(sampledValues.size() < sampleSize)
+	{
+		sampledValues.push_back(value);
+		return;
+	}
+
+	// keep each of values added so far in sample with equal probability
+	uint64_t index = std::uniform_int_distribution<uint64_t>(0, count - 1)(random);
+	if(index < sampleSize)
+		sampledValues[index] = value;
+}
+
+uint64_t SampledStatistics::getCount() const
+{
+	return count;
+}
+
+int64_t SampledStatistics::getTotal() const
+{
+	return total;
+}
+
+int64_t SampledStatistics::getMaximum() const
+{
+	return maximum;
+}
+
+int64_t SampledStatistics::getPercentile(size_t percent) const
+{
+	if(sampledValues.empty())
+		return 0;
+
+	std::vector<int64_t> values = sampledValues;
+	size_t index = (values.size() - 1) * std::min<size_t>(percent, 100) / 100;
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,39 @@
+/*
+ * SampledStatistics.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Accumulates count, sum and maximum of measured values, such as durations.
+/// Only a uniformly chosen random subset of values is kept (reservoir sampling),
+/// so percentiles can be estimated over any number of values with bounded memory usage
+class DLL_LINKAGE SampledStatistics
+{
+	size_t sampleSize;
+	uint64_t count = 0;
+	int64_t total = 0;
+	int64_t maximum = 0;
+	std::vector<int64_t> sampledValues;
+	std::minstd_rand random;
+
+public:
+	explicit SampledStatistics(size_t sampleSize);
+
+	void add(int64_t value);
+
+	uint64_t getCount() const;
+	int64_t getTotal() const;
+	int64_t getMaximum() const;
+
+	/// Returns estimated value below which given percent of values lie, or 0 if no values were added
+	int64_t getPercentile(size_t percent) const;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,165 @@
+/*
+ * TraceProfiler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "TraceProfiler.h"
+
+#include "CThreadHelper.h"
+#include "VCMIDirs.h"
+#include "vstd/DateUtils.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Limit on number of zones stored per thread, to keep memory usage bounded if profiler is left running
+static constexpr size_t maxEventsPerThread = 1 << 20;
+
+struct TraceProfiler::ThreadBuffer
+{
+	std::mutex mutex;
+	std::vector<Event> events;
+	std::string threadName;
+	size_t threadIndex = 0;
+	size_t droppedEvents = 0;
+};
+
+TraceProfiler & TraceProfiler::get()
+{
+	static TraceProfiler instance;
+	return instance;
+}
+
+TraceProfiler::TraceProfiler()
+	: running(std::getenv("VCMI_TRACE_PROFILER") != nullptr)
+	, startTime(std::chrono::steady_clock::now())
+{
+}
+
+void TraceProfiler::start()
+{
+	TLockGuard _(buffersMutex);
+	for(const auto & buffer : buffers)
+	{
+		TLockGuard bufferLock(buffer->mutex);
+		buffer->events.clear();
+		buffer->droppedEvents = 0;
+	}
+
+	running = true;
+	logGlobal->info("Trace profiler started");
+}
+
+void TraceProfiler::stop()
+{
+	running = false;
+	logGlobal->info("Trace profiler stopped");
+}
+
+int64_t TraceProfiler::currentTime() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+TraceProfiler::ThreadBuffer & TraceProfiler::getThreadBuffer()
+{
+	thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+
+	if(!threadBuffer)
+	{
+		threadBuffer = std::make_shared<ThreadBuffer>();
+		threadBuffer->threadName = getThreadName();
+
+		TLockGuard _(buffersMutex);
+		threadBuffer->threadIndex = buffers.size() + 1;
+		buffers.push_back(threadBuffer);
+	}
+	return *threadBuffer;
+}
+
+void TraceProfiler::addEvent(const Event & event)
+{
+	auto & buffer = getThreadBuffer();
+
+	// lock is only contended while dumping collected data
+	TLockGuard _(buffer.mutex);
+	if(buffer.events.size() < maxEventsPerThread)
+		buffer.events.push_back(event);
+	else
+		buffer.droppedEvents += 1;
+}
+
+static void writeEscapedString(std::ostream & out, const std::string & string)
+{
+	out << '"';
+	for(char c : string)
+	{
+		if(c == '"' || c == '\\')
+			out << '\\' << c;
+		else if(static_cast<unsigned char>(c) < 0x20)
+			out << ' ';
+		else
+			out << c;
+	}
+	out << '"';
+}
+
+void TraceProfiler::dump(const boost::filesystem::path & filePath)
+{
+	std::ofstream file(filePath.c_str());
+	if(!file)
+		throw std::runtime_error("Failed to open trace file " + filePath.string());
+
+	size_t totalEvents = 0;
+	bool firstEvent = true;
+	const auto & separator = [&]() -> std::ostream &
+	{
+		if(!firstEvent)
+			file << ",\n";
+		firstEvent = false;
+		return file;
+	};
+
+	file << "{\"traceEvents\":[\n";
+
+	TLockGuard _(buffersMutex);
+	for(const auto & buffer : buffers)
+	{
+		TLockGuard bufferLock(buffer->mutex);
+
+		separator() << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << buffer->threadIndex << R"(,"args":{"name":)";
+		writeEscapedString(file, buffer->threadName);
+		file << "}}";
+
+		for(const auto & event : buffer->events)
+		{
+			separator() << R"({"ph":"X","pid":1,"tid":)" << buffer->threadIndex << R"(,"ts":)" << event.startMicroseconds << R"(,"dur":)" << event.durationMicroseconds << R"(,"name":)";
+			writeEscapedString(file, event.name);
+			file << '}';
+		}
+
+		totalEvents += buffer->events.size();
+		if(buffer->droppedEvents != 0)
+			logGlobal->warn("Trace profiler: %d zones from thread %s were dropped due to buffer limit", buffer->droppedEvents, buffer->threadName);
+	}
+
+	file << "\n]}\n";
+
+	logGlobal->info("Trace profiler: written %d zones from %d threads to %s", totalEvents, buffers.size(), filePath.string());
+}
+
+std::string TraceProfiler::dump()
+{
+	const boost::filesystem::path outPath = VCMIDirs::get().userCachePath() / "traces";
+	boost::filesystem::create_directories(outPath);
+
+	const boost::filesystem::path filePath = outPath / (vstd::getDateTimeISO8601Basic(std::time(nullptr)) + ".json");
+	dump(filePath);
+	return filePath.string();
+}
+
+VCMI_LIB_NAMESPACE_END
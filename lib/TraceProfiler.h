@@ -0,0 +1,97 @@
+/*
+ * TraceProfiler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Lightweight instrumentation profiler that collects timed zones from all threads
+/// and exports them in Chrome trace event format (chrome://tracing, ui.perfetto.dev)
+/// When profiler is not running, cost of each zone is a single atomic load
+/// Setting VCMI_TRACE_PROFILER environment variable starts profiler immediately, which allows profiling of startup
+class DLL_LINKAGE TraceProfiler : boost::noncopyable
+{
+public:
+	struct Event
+	{
+		/// Zone name, must point to a string with static storage duration
+		const char * name;
+		int64_t startMicroseconds;
+		int64_t durationMicroseconds;
+	};
+
+	static TraceProfiler & get();
+
+	/// Clears previously collected data and starts recording of new zones
+	void start();
+	/// Stops recording of new zones. Collected data is kept until next start
+	void stop();
+
+	bool isRunning() const
+	{
+		return running.load(std::memory_order_relaxed);
+	}
+
+	/// Writes all collected zones to specified file in Chrome trace event JSON format
+	void dump(const boost::filesystem::path & filePath);
+
+	/// Writes collected zones to timestamped file in user cache directory. Returns path to written file
+	std::string dump();
+
+	int64_t currentTime() const;
+	void addEvent(const Event & event);
+
+private:
+	struct ThreadBuffer;
+
+	TraceProfiler();
+	ThreadBuffer & getThreadBuffer();
+
+	std::atomic<bool> running;
+	const std::chrono::steady_clock::time_point startTime;
+
+	std::mutex buffersMutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+/// Records duration of a scope in TraceProfiler
+class TraceZone : boost::noncopyable
+{
+	const char * name;
+	int64_t startMicroseconds;
+
+public:
+	explicit TraceZone(const char * name)
+		: name(nullptr)
+		, startMicroseconds(0)
+	{
+		if(!TraceProfiler::get().isRunning())
+			return;
+
+		this->name = name;
+		startMicroseconds = TraceProfiler::get().currentTime();
+	}
+
+	~TraceZone()
+	{
+		if(!name)
+			return;
+
+		auto & profiler = TraceProfiler::get();
+		profiler.addEvent({name, startMicroseconds, profiler.currentTime() - startMicroseconds});
+	}
+};
+
+#define VCMI_TRACE_CONCAT_IMPL(a, b) a##b
+#define VCMI_TRACE_CONCAT(a, b) VCMI_TRACE_CONCAT_IMPL(a, b)
+
+/// Profiles remaining part of current scope. Name must be string literal
+#define VCMI_PROFILE_ZONE(zoneName) TraceZone VCMI_TRACE_CONCAT(traceZone, __LINE__)(zoneName)
+
+VCMI_LIB_NAMESPACE_END
@@ -30,6 +30,7 @@
 #include "modding/CModVersion.h"
 #include "IGameEventsReceiver.h"
 #include "CStopWatch.h"
+#include "TraceProfiler.h"
 #include "VCMIDirs.h"
 #include "filesystem/Filesystem.h"
 #include "CConsoleHandler.h"
@@ -176,6 +177,8 @@ template <class Handler> void createHandler(std::shared_ptr<Handler> & handler,
 
 void LibClasses::init(bool onlyEssential)
 {
+	VCMI_PROFILE_ZONE("LibClasses::init");
+
 	CStopWatch pomtime;
 	CStopWatch totalTime;
 
@@ -206,8 +209,14 @@ void LibClasses::init(bool onlyEssential)
 	createHandler(obstacleHandler, "Obstacles", pomtime);
 	logGlobal->info("\tInitializing handlers: %d ms", totalTime.getDiff());
 
-	modh->load();
-	modh->afterLoad(onlyEssential);
+	{
+		VCMI_PROFILE_ZONE("CModHandler::load");
+		modh->load();
+	}
+	{
+		VCMI_PROFILE_ZONE("CModHandler::afterLoad");
+		modh->afterLoad(onlyEssential);
+	}
 }
 
 #if SCRIPTING_ENABLED
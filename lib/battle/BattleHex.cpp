@@ -12,33 +12,100 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-BattleHex::BattleHex() : hex(INVALID) {}
+/// constexpr version of BattleHex::cloneInDirection(dir, false), used to generate lookup tables at compile time
+static constexpr BattleHex neighbourInDirection(BattleHex hex, BattleHex::EDir dir)
+{
+	si16 x = hex.getX();
+	si16 y = hex.getY();
+	switch(dir)
+	{
+	case BattleHex::TOP_LEFT:
+		return (y%2 ? x-1 : x) + (y-1) * GameConstants::BFIELD_WIDTH;
+	case BattleHex::TOP_RIGHT:
+		return (y%2 ? x : x+1) + (y-1) * GameConstants::BFIELD_WIDTH;
+	case BattleHex::RIGHT:
+		return (x+1) + y * GameConstants::BFIELD_WIDTH;
+	case BattleHex::BOTTOM_RIGHT:
+		return (y%2 ? x : x+1) + (y+1) * GameConstants::BFIELD_WIDTH;
+	case BattleHex::BOTTOM_LEFT:
+		return (y%2 ? x-1 : x) + (y+1) * GameConstants::BFIELD_WIDTH;
+	case BattleHex::LEFT:
+		return (x-1) + y * GameConstants::BFIELD_WIDTH;
+	default:
+		return hex;
+	}
+}
 
-BattleHex::BattleHex(si16 _hex) : hex(_hex) {}
+static constexpr uint8_t calculateDistance(BattleHex hex1, BattleHex hex2)
+{
+	int y1 = hex1.getY();
+	int y2 = hex2.getY();
 
-BattleHex::BattleHex(si16 x, si16 y)
+	int x1 = hex1.getX() + y1 / 2;
+	int x2 = hex2.getX() + y2 / 2;
+
+	int xDst = x2 - x1;
+	int yDst = y2 - y1;
+
+	int xAbs = xDst < 0 ? -xDst : xDst;
+	int yAbs = yDst < 0 ? -yDst : yDst;
+
+	if ((xDst >= 0 && yDst >= 0) || (xDst < 0 && yDst < 0))
+		return std::max(xAbs, yAbs);
+
+	return xAbs + yAbs;
+}
+
+static constexpr std::array<std::array<BattleHex, 6>, GameConstants::BFIELD_SIZE> calculateAllNeighbouringTiles()
 {
-	setXY(x, y);
+	std::array<std::array<BattleHex, 6>, GameConstants::BFIELD_SIZE> result{};
+
+	for(si16 hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+	{
+		for(auto dir : BattleHex::hexagonalDirections())
+			result[hex][dir] = neighbourInDirection(hex, dir);
+	}
+	return result;
 }
 
-BattleHex::BattleHex(std::pair<si16, si16> xy)
+static constexpr std::array<BattleHexNeighbours, GameConstants::BFIELD_SIZE> calculateNeighbouringTiles()
 {
-	setXY(xy);
+	std::array<BattleHexNeighbours, GameConstants::BFIELD_SIZE> result{};
+
+	for(si16 hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+	{
+		for(auto dir : BattleHex::hexagonalDirections())
+		{
+			BattleHex neighbour = neighbourInDirection(hex, dir);
+			if(neighbour.isAvailable())
+				result[hex].push_back(neighbour);
+		}
+	}
+	return result;
 }
 
-BattleHex::operator si16() const
+static constexpr std::array<std::array<uint8_t, GameConstants::BFIELD_SIZE>, GameConstants::BFIELD_SIZE> calculateDistances()
 {
-	return hex;
+	std::array<std::array<uint8_t, GameConstants::BFIELD_SIZE>, GameConstants::BFIELD_SIZE> result{};
+
+	for(si16 hex1 = 0; hex1 < GameConstants::BFIELD_SIZE; hex1++)
+		for(si16 hex2 = 0; hex2 < GameConstants::BFIELD_SIZE; hex2++)
+			result[hex1][hex2] = calculateDistance(hex1, hex2);
+	return result;
 }
 
-bool BattleHex::isValid() const
+static constexpr auto allNeighbouringTilesTable = calculateAllNeighbouringTiles();
+static constexpr auto neighbouringTilesTable = calculateNeighbouringTiles();
+static constexpr auto distanceTable = calculateDistances();
+
+BattleHex::BattleHex(si16 x, si16 y)
 {
-	return hex >= 0 && hex < GameConstants::BFIELD_SIZE;
+	setXY(x, y);
 }
 
-bool BattleHex::isAvailable() const
+BattleHex::BattleHex(std::pair<si16, si16> xy)
 {
-	return isValid() && getX() > 0 && getX() < GameConstants::BFIELD_WIDTH-1;
+	setXY(xy);
 }
 
 void BattleHex::setX(si16 x)
@@ -67,16 +134,6 @@ void BattleHex::setXY(std::pair<si16, si16> xy)
 	setXY(xy.first, xy.second);
 }
 
-si16 BattleHex::getX() const
-{
-	return hex % GameConstants::BFIELD_WIDTH;
-}
-
-si16 BattleHex::getY() const
-{
-	return hex / GameConstants::BFIELD_WIDTH;
-}
-
 std::pair<si16, si16> BattleHex::getXY() const
 {
 	return std::make_pair(getX(), getY());
@@ -132,50 +189,47 @@ BattleHex BattleHex::operator+(BattleHex::EDir dir) const
 	return cloneInDirection(dir);
 }
 
-std::vector<BattleHex> BattleHex::neighbouringTiles() const
+const BattleHexNeighbours & BattleHex::neighbouringTiles() const
 {
-	std::vector<BattleHex> ret;
-	ret.reserve(6);
-	for(auto dir : hexagonalDirections())
-		checkAndPush(cloneInDirection(dir, false), ret);
-	return ret;
+	static const BattleHexNeighbours noNeighbours;
+
+	if(!isValid())
+		return noNeighbours;
+	return neighbouringTilesTable[hex];
 }
 
-std::vector<BattleHex> BattleHex::allNeighbouringTiles() const
+const std::array<BattleHex, 6> & BattleHex::allNeighbouringTiles() const
 {
-	std::vector<BattleHex> ret;
-	ret.resize(6);
-
-	for(auto dir : hexagonalDirections())
-		ret[dir] = cloneInDirection(dir, false);
+	static const std::array<BattleHex, 6> noNeighbours;
 
-	return ret;
+	if(!isValid())
+		return noNeighbours;
+	return allNeighbouringTilesTable[hex];
 }
 
 BattleHex::EDir BattleHex::mutualPosition(BattleHex hex1, BattleHex hex2)
 {
+	if(hex1.isValid())
+	{
+		const auto & neighbours = allNeighbouringTilesTable[hex1];
+		for(auto dir : hexagonalDirections())
+			if(hex2 == neighbours[dir])
+				return dir;
+		return NONE;
+	}
+
 	for(auto dir : hexagonalDirections())
-		if(hex2 == hex1.cloneInDirection(dir, false))
+		if(hex2 == neighbourInDirection(hex1, dir))
 			return dir;
 	return NONE;
 }
 
 uint8_t BattleHex::getDistance(BattleHex hex1, BattleHex hex2)
 {
-	int y1 = hex1.getY();
-	int y2 = hex2.getY();
-
-	// FIXME: why there was * 0.5 instead of / 2?
-	int x1 = static_cast<int>(hex1.getX() + y1 / 2);
-	int x2 = static_cast<int>(hex2.getX() + y2 / 2);
-
-	int xDst = x2 - x1;
-	int yDst = y2 - y1;
+	if(hex1.isValid() && hex2.isValid())
+		return distanceTable[hex1][hex2];
 
-	if ((xDst >= 0 && yDst >= 0) || (xDst < 0 && yDst < 0))
-		return std::max(std::abs(xDst), std::abs(yDst));
-
-	return std::abs(xDst) + std::abs(yDst);
+	return calculateDistance(hex1, hex2);
 }
 
 void BattleHex::checkAndPush(BattleHex tile, std::vector<BattleHex> & ret)
@@ -184,62 +238,59 @@ void BattleHex::checkAndPush(BattleHex tile, std::vector<BattleHex> & ret)
 		ret.push_back(tile);
 }
 
-BattleHex BattleHex::getClosestTile(BattleSide side, BattleHex initialPos, std::set<BattleHex> & possibilities)
+template<typename Container>
+static BattleHex getClosestTileImpl(BattleSide side, BattleHex initialPos, const Container & possibilities)
 {
-	std::vector<BattleHex> sortedTiles (possibilities.begin(), possibilities.end()); //set can't be sorted properly :(
-	BattleHex initialHex = BattleHex(initialPos);
-	auto compareDistance = [initialHex](const BattleHex left, const BattleHex right) -> bool
-	{
-		return initialHex.getDistance (initialHex, left) < initialHex.getDistance (initialHex, right);
-	};
-	boost::sort (sortedTiles, compareDistance); //closest tiles at front
-	int closestDistance = initialHex.getDistance(initialPos, sortedTiles.front()); //sometimes closest tiles can be many hexes away
-	auto notClosest = [closestDistance, initialPos](const BattleHex here) -> bool
-	{
-		return closestDistance < here.getDistance (initialPos, here);
-	};
-	vstd::erase_if(sortedTiles, notClosest); //only closest tiles are interesting
-	auto compareHorizontal = [side, initialPos](const BattleHex left, const BattleHex right) -> bool
+	// Single pass over all candidates, equivalent to selecting closest tiles and then sorting them horizontally
+	BattleHex bestTile;
+	int bestDistance = std::numeric_limits<int>::max();
+
+	for(BattleHex tile : possibilities)
 	{
-		if(left.getX() != right.getX())
+		int distance = BattleHex::getDistance(initialPos, tile);
+
+		if(distance > bestDistance)
+			continue;
+
+		if(distance == bestDistance)
 		{
-			if(side == BattleSide::ATTACKER)
-				return left.getX() > right.getX(); //find furthest right
+			if(tile.getX() != bestTile.getX())
+			{
+				bool tileIsBetter = side == BattleSide::ATTACKER
+					? tile.getX() > bestTile.getX() //find furthest right
+					: tile.getX() < bestTile.getX(); //find furthest left
+
+				if(!tileIsBetter)
+					continue;
+			}
 			else
-				return left.getX() < right.getX(); //find furthest left
-		}
-		else
-		{
-			//Prefer tiles in the same row.
-			return std::abs(left.getY() - initialPos.getY()) < std::abs(right.getY() - initialPos.getY());
+			{
+				//Prefer tiles in the same row.
+				if(std::abs(tile.getY() - initialPos.getY()) >= std::abs(bestTile.getY() - initialPos.getY()))
+					continue;
+			}
 		}
-	};
-	boost::sort (sortedTiles, compareHorizontal);
-	return sortedTiles.front();
+
+		bestTile = tile;
+		bestDistance = distance;
+	}
+
+	return bestTile;
 }
 
-std::ostream & operator<<(std::ostream & os, const BattleHex & hex)
+BattleHex BattleHex::getClosestTile(BattleSide side, BattleHex initialPos, const std::set<BattleHex> & possibilities)
 {
-	return os << boost::str(boost::format("{BattleHex: x '%d', y '%d', hex '%d'}") % hex.getX() % hex.getY() % hex.hex);
+	return getClosestTileImpl(side, initialPos, possibilities);
 }
 
-static BattleHex::NeighbouringTilesCache calculateNeighbouringTiles()
+BattleHex BattleHex::getClosestTile(BattleSide side, BattleHex initialPos, const BattleHexNeighbours & possibilities)
 {
-	BattleHex::NeighbouringTilesCache ret;
-	ret.resize(GameConstants::BFIELD_SIZE);
-
-	for(si16 hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
-	{
-		auto hexes = BattleHex(hex).neighbouringTiles();
-
-		size_t index = 0;
-		for(auto neighbour : hexes)
-			ret[hex].at(index++) = neighbour;
-	}
-
-	return ret;
+	return getClosestTileImpl(side, initialPos, possibilities);
 }
 
-const BattleHex::NeighbouringTilesCache BattleHex::neighbouringTilesCache = calculateNeighbouringTiles();
+std::ostream & operator<<(std::ostream & os, const BattleHex & hex)
+{
+	return os << boost::str(boost::format("{BattleHex: x '%d', y '%d', hex '%d'}") % hex.getX() % hex.getY() % hex.hex);
+}
 
 VCMI_LIB_NAMESPACE_END
@@ -13,6 +13,8 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+class BattleHexNeighbours;
+
 //TODO: change to enum class
 
 namespace GameConstants
@@ -64,36 +66,67 @@ struct DLL_LINKAGE BattleHex //TODO: decide if this should be changed to class f
 		BOTTOM
 	};
 
-	BattleHex();
-	BattleHex(si16 _hex);
+	constexpr BattleHex()
+		: hex(INVALID)
+	{}
+
+	constexpr BattleHex(si16 _hex)
+		: hex(_hex)
+	{}
+
 	BattleHex(si16 x, si16 y);
 	BattleHex(std::pair<si16, si16> xy);
-	operator si16() const;
-	bool isValid() const;
-	bool isAvailable() const; //valid position not in first or last column
+
+	constexpr operator si16() const
+	{
+		return hex;
+	}
+
+	constexpr bool isValid() const
+	{
+		return hex >= 0 && hex < GameConstants::BFIELD_SIZE;
+	}
+
+	/// valid position not in first or last column
+	constexpr bool isAvailable() const
+	{
+		return isValid() && getX() > 0 && getX() < GameConstants::BFIELD_WIDTH-1;
+	}
+
 	void setX(si16 x);
 	void setY(si16 y);
 	void setXY(si16 x, si16 y, bool hasToBeValid = true);
 	void setXY(std::pair<si16, si16> xy);
-	si16 getX() const;
-	si16 getY() const;
+
+	constexpr si16 getX() const
+	{
+		return hex % GameConstants::BFIELD_WIDTH;
+	}
+
+	constexpr si16 getY() const
+	{
+		return hex / GameConstants::BFIELD_WIDTH;
+	}
+
 	std::pair<si16, si16> getXY() const;
 	BattleHex& moveInDirection(EDir dir, bool hasToBeValid = true);
 	BattleHex& operator+=(EDir dir);
 	BattleHex cloneInDirection(EDir dir, bool hasToBeValid = true) const;
 	BattleHex operator+(EDir dir) const;
 
-	/// returns all valid neighbouring tiles
-	std::vector<BattleHex> neighbouringTiles() const;
+	/// returns all valid neighbouring tiles. Result is taken from precomputed table
+	const BattleHexNeighbours & neighbouringTiles() const;
 
-	/// returns all tiles, unavailable tiles will be set as invalid
-	/// order of returned tiles matches EDir enim
-	std::vector<BattleHex> allNeighbouringTiles() const;
+	/// returns all tiles, without checking whether they are available
+	/// order of returned tiles matches EDir enum. Result is taken from precomputed table
+	const std::array<BattleHex, 6> & allNeighbouringTiles() const;
 
 	static EDir mutualPosition(BattleHex hex1, BattleHex hex2);
+	/// Returns distance between two hexes. Uses precomputed table if both hexes are valid
 	static uint8_t getDistance(BattleHex hex1, BattleHex hex2);
 	static void checkAndPush(BattleHex tile, std::vector<BattleHex> & ret);
-	static BattleHex getClosestTile(BattleSide side, BattleHex initialPos, std::set<BattleHex> & possibilities); //TODO: vector or set? copying one to another is bad
+	static BattleHex getClosestTile(BattleSide side, BattleHex initialPos, const std::set<BattleHex> & possibilities);
+	static BattleHex getClosestTile(BattleSide side, BattleHex initialPos, const BattleHexNeighbours & possibilities);
 
 	template <typename Handler>
 	void serialize(Handler &h)
@@ -101,17 +134,66 @@ struct DLL_LINKAGE BattleHex //TODO: decide if this should be changed to class f
 		h & hex;
 	}
 
-    using NeighbouringTiles = std::array<BattleHex, 6>;
-    using NeighbouringTilesCache = std::vector<NeighbouringTiles>;
-
-    static const NeighbouringTilesCache neighbouringTilesCache;
-private:
 	//Constexpr defined array with all directions used in battle
 	static constexpr auto hexagonalDirections() {
 		return std::array<EDir,6>{BattleHex::TOP_LEFT, BattleHex::TOP_RIGHT, BattleHex::RIGHT, BattleHex::BOTTOM_RIGHT, BattleHex::BOTTOM_LEFT, BattleHex::LEFT};
 	}
 };
 
+/// List of up to 6 neighbouring hexes with fixed storage, which allows geometry queries without memory allocation
+class BattleHexNeighbours
+{
+	std::array<BattleHex, 6> tiles;
+	uint8_t tilesCount = 0;
+
+public:
+	using value_type = BattleHex;
+	using const_iterator = const BattleHex *;
+	using iterator = const_iterator;
+
+	constexpr void push_back(BattleHex tile)
+	{
+		tiles[tilesCount++] = tile;
+	}
+
+	constexpr const BattleHex * begin() const
+	{
+		return tiles.data();
+	}
+
+	constexpr const BattleHex * end() const
+	{
+		return tiles.data() + tilesCount;
+	}
+
+	constexpr size_t size() const
+	{
+		return tilesCount;
+	}
+
+	constexpr bool empty() const
+	{
+		return tilesCount == 0;
+	}
+
+	constexpr BattleHex operator[](size_t index) const
+	{
+		return tiles[index];
+	}
+
+	BattleHex at(size_t index) const
+	{
+		if(index >= tilesCount)
+			throw std::out_of_range("BattleHexNeighbours index out of range");
+		return tiles[index];
+	}
+
+	bool contains(BattleHex tile) const
+	{
+		return std::find(begin(), end(), tile) != end();
+	}
+};
+
 DLL_EXPORT std::ostream & operator<<(std::ostream & os, const BattleHex & hex);
 
 VCMI_LIB_NAMESPACE_END
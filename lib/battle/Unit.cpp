@@ -88,7 +88,8 @@ std::vector<BattleHex> Unit::getSurroundingHexes(BattleHex position, bool twoHex
 	}
 	else
 	{
-		return position.neighbouringTiles();
+		const auto & neighbours = position.neighbouringTiles();
+		return {neighbours.begin(), neighbours.end()};
 	}
 }
 
@@ -112,7 +113,10 @@ std::vector<BattleHex> Unit::getAttackableHexes(const Unit * attacker) const
 			hexes.pop_back();
 
 		for(auto hex : hexes)
-			vstd::concatenate(targetableHexes, hex.neighbouringTiles());
+		{
+			const auto & neighbours = hex.neighbouringTiles();
+			targetableHexes.insert(targetableHexes.end(), neighbours.begin(), neighbours.end());
+		}
 	}
 
 	vstd::removeDuplicates(targetableHexes);
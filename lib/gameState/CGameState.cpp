@@ -54,6 +54,8 @@
 
 #include <vstd/RNG.h>
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 boost::shared_mutex CGameState::mutex;
@@ -676,12 +678,7 @@ void CGameState::initFogOfWar()
 		{
 			if(!obj || !vstd::contains(elem.second.players, obj->tempOwner)) continue; //not a flagged object
 
-			std::unordered_set<int3> tiles;
-			getTilesInRange(tiles, obj->getSightCenter(), obj->getSightRadius(), ETileVisibility::HIDDEN, obj->tempOwner);
-			for(const int3 & tile : tiles)
-			{
-				elem.second.fogOfWarMap[tile.z][tile.x][tile.y] = 1;
-			}
+			revealTilesInRange(fow, obj->getSightCenter(), obj->getSightRadius());
 		}
 	}
 }
@@ -1158,59 +1155,27 @@ void CGameState::calculatePaths(const std::shared_ptr<PathfinderConfig> & config
 	pathfinder.calculatePaths();
 }
 
-/**
- * Tells if the tile is guarded by a monster as well as the position
- * of the monster that will attack on it.
- *
- * @return int3(-1, -1, -1) if the tile is unguarded, or the position of
- * the monster guarding the tile.
- */
-std::vector<CGObjectInstance*> CGameState::guardingCreatures (int3 pos) const
+void CGameState::calculatePaths(const std::vector<std::shared_ptr<PathfinderConfig>> & configs)
 {
-	std::vector<CGObjectInstance*> guards;
-	const int3 originalPos = pos;
-	if (!map->isInTheMap(pos))
-		return guards;
-
-	const TerrainTile &posTile = map->getTile(pos);
-	if (posTile.visitable)
+	// pathfinder only reads gamestate, so paths of different heroes can be calculated in parallel
+	// as long as every config writes into its own node storage
+	if(configs.size() < 2)
 	{
-		for (CGObjectInstance* obj : posTile.visitableObjects)
-		{
-			if(obj->isBlockedVisitable())
-			{
-				if (obj->ID == Obj::MONSTER) // Monster
-					guards.push_back(obj);
-			}
-		}
+		for(const auto & config : configs)
+			calculatePaths(config);
+		return;
 	}
-	pos -= int3(1, 1, 0); // Start with top left.
-	for (int dx = 0; dx < 3; dx++)
-	{
-		for (int dy = 0; dy < 3; dy++)
-		{
-			if (map->isInTheMap(pos))
-			{
-				const auto & tile = map->getTile(pos);
-				if (tile.visitable && (tile.isWater() == posTile.isWater()))
-				{
-					for (CGObjectInstance* obj : tile.visitableObjects)
-					{
-						if (obj->ID == Obj::MONSTER  &&  map->checkForVisitableDir(pos, &map->getTile(originalPos), originalPos)) // Monster being able to attack investigated tile
-						{
-							guards.push_back(obj);
-						}
-					}
-				}
-			}
 
-			pos.y++;
-		}
-		pos.y -= 3;
-		pos.x++;
-	}
-	return guards;
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, configs.size(), 1), [this, &configs](const tbb::blocked_range<size_t> & r)
+	{
+		for(auto i = r.begin(); i != r.end(); ++i)
+			calculatePaths(configs[i]);
+	});
+}
 
+std::vector<CGObjectInstance*> CGameState::guardingCreatures (int3 pos) const
+{
+	return map->getGuardingCreatures(pos);
 }
 
 int3 CGameState::guardingCreaturePosition (int3 pos) const
@@ -32,6 +32,11 @@ void StatisticDataSet::add(StatisticDataSetEntry entry)
 	data.push_back(entry);
 }
 
+void StatisticDataSet::removeDaysBefore(int day)
+{
+	vstd::erase_if(data, [day](const StatisticDataSetEntry & entry){ return entry.day < day; });
+}
+
 StatisticDataSetEntry StatisticDataSet::createEntry(const PlayerState * ps, const CGameState * gs)
 {
 	StatisticDataSetEntry data;
@@ -63,28 +68,45 @@ StatisticDataSetEntry StatisticDataSet::createEntry(const PlayerState * ps, cons
 	data.hasGrail = param.hasGrail;
 	data.numMines = Statistic::getNumMines(gs, ps);
 	data.score = scenarioHighScores.calculate().total;
-	data.maxHeroLevel = Statistic::findBestHero(gs, ps->color) ? Statistic::findBestHero(gs, ps->color)->level : 0;
-	data.numBattlesNeutral = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).numBattlesNeutral : 0;
-	data.numBattlesPlayer = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).numBattlesPlayer : 0;
-	data.numWinBattlesNeutral = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).numWinBattlesNeutral : 0;
-	data.numWinBattlesPlayer = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).numWinBattlesPlayer : 0;
-	data.numHeroSurrendered = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).numHeroSurrendered : 0;
-	data.numHeroEscaped = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).numHeroEscaped : 0;
-	data.spentResourcesForArmy = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).spentResourcesForArmy : TResources();
-	data.spentResourcesForBuildings = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).spentResourcesForBuildings : TResources();
-	data.tradeVolume = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).tradeVolume : TResources();
-	data.eventCapturedTown = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).lastCapturedTownDay == gs->getDate(Date::DAY) : false;
-	data.eventDefeatedStrongestHero = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).lastDefeatedStrongestHeroDay == gs->getDate(Date::DAY) : false;
-	data.movementPointsUsed = gs->statistic.accumulatedValues.count(ps->color) ? gs->statistic.accumulatedValues.at(ps->color).movementPointsUsed : 0;
+	const auto * bestHero = Statistic::findBestHero(gs, ps->color);
+	data.maxHeroLevel = bestHero ? bestHero->level : 0;
+
+	PlayerAccumulatedValueStorage accumulated = {};
+	auto accumulatedIt = gs->statistic.accumulatedValues.find(ps->color);
+	if(accumulatedIt != gs->statistic.accumulatedValues.end())
+		accumulated = accumulatedIt->second;
+	else
+	{
+		accumulated.lastCapturedTownDay = -1;
+		accumulated.lastDefeatedStrongestHeroDay = -1;
+	}
+
+	data.numBattlesNeutral = accumulated.numBattlesNeutral;
+	data.numBattlesPlayer = accumulated.numBattlesPlayer;
+	data.numWinBattlesNeutral = accumulated.numWinBattlesNeutral;
+	data.numWinBattlesPlayer = accumulated.numWinBattlesPlayer;
+	data.numHeroSurrendered = accumulated.numHeroSurrendered;
+	data.numHeroEscaped = accumulated.numHeroEscaped;
+	data.spentResourcesForArmy = accumulated.spentResourcesForArmy;
+	data.spentResourcesForBuildings = accumulated.spentResourcesForBuildings;
+	data.tradeVolume = accumulated.tradeVolume;
+	data.eventCapturedTown = accumulated.lastCapturedTownDay == gs->getDate(Date::DAY);
+	data.eventDefeatedStrongestHero = accumulated.lastDefeatedStrongestHeroDay == gs->getDate(Date::DAY);
+	data.movementPointsUsed = accumulated.movementPointsUsed;
 
 	return data;
 }
 
-std::string StatisticDataSet::toCsv(std::string sep)
+static const std::vector<EGameResID> & csvResources()
 {
-	std::stringstream ss;
+	static const std::vector<EGameResID> resources = {EGameResID::GOLD, EGameResID::WOOD, EGameResID::MERCURY, EGameResID::ORE, EGameResID::SULFUR, EGameResID::CRYSTAL, EGameResID::GEMS};
+	return resources;
+}
 
-	auto resources = std::vector<EGameResID>{EGameResID::GOLD, EGameResID::WOOD, EGameResID::MERCURY, EGameResID::ORE, EGameResID::SULFUR, EGameResID::CRYSTAL, EGameResID::GEMS};
+std::string StatisticDataSet::toCsvHeader(const std::string & sep)
+{
+	std::stringstream ss;
+	const auto & resources = csvResources();
 
 	ss << "Map" << sep;
 	ss << "Timestamp" << sep;
@@ -128,54 +150,70 @@ std::string StatisticDataSet::toCsv(std::string sep)
 		ss << sep << GameConstants::RESOURCE_NAMES[resource] + "TradeVolume";
 	ss << "\r\n";
 
-	for(auto & entry : data)
-	{
-		ss << entry.map << sep;
-		ss << vstd::getFormattedDateTime(entry.timestamp, "%Y-%m-%dT%H:%M:%S") << sep;
-		ss << entry.day << sep;
-		ss << GameConstants::PLAYER_COLOR_NAMES[entry.player] << sep;
-		ss << entry.playerName << sep;
-		ss << entry.team.getNum() << sep;
-		ss << entry.isHuman << sep;
-		ss << static_cast<int>(entry.status) << sep;
-		ss << entry.numberHeroes << sep;
-		ss << entry.numberTowns <<  sep;
-		ss << entry.numberArtifacts << sep;
-		ss << entry.numberDwellings << sep;
-		ss << entry.armyStrength << sep;
-		ss << entry.totalExperience << sep;
-		ss << entry.income << sep;
-		ss << entry.mapExploredRatio << sep;
-		ss << entry.obeliskVisitedRatio << sep;
-		ss << entry.townBuiltRatio << sep;
-		ss << entry.hasGrail << sep;
-		ss << entry.score << sep;
-		ss << entry.maxHeroLevel << sep;
-		ss << entry.numBattlesNeutral << sep;
-		ss << entry.numBattlesPlayer << sep;
-		ss << entry.numWinBattlesNeutral << sep;
-		ss << entry.numWinBattlesPlayer << sep;
-		ss << entry.numHeroSurrendered << sep;
-		ss << entry.numHeroEscaped << sep;
-		ss << entry.eventCapturedTown << sep;
-		ss << entry.eventDefeatedStrongestHero << sep;
-		ss << entry.movementPointsUsed;
-		for(auto & resource : resources)
-			ss << sep << entry.resources[resource];
-		for(auto & resource : resources)
-			ss << sep << entry.numMines[resource];
-		for(auto & resource : resources)
-			ss << sep << entry.spentResourcesForArmy[resource];
-		for(auto & resource : resources)
-			ss << sep << entry.spentResourcesForBuildings[resource];
-		for(auto & resource : resources)
-			ss << sep << entry.tradeVolume[resource];
-		ss << "\r\n";
-	}
 
 	return ss.str();
 }
 
+std::string StatisticDataSet::toCsvRow(const StatisticDataSetEntry & entry, const std::string & sep)
+{
+	std::stringstream ss;
+	const auto & resources = csvResources();
+
+	ss << entry.map << sep;
+	ss << vstd::getFormattedDateTime(entry.timestamp, "%Y-%m-%dT%H:%M:%S") << sep;
+	ss << entry.day << sep;
+	ss << GameConstants::PLAYER_COLOR_NAMES[entry.player] << sep;
+	ss << entry.playerName << sep;
+	ss << entry.team.getNum() << sep;
+	ss << entry.isHuman << sep;
+	ss << static_cast<int>(entry.status) << sep;
+	ss << entry.numberHeroes << sep;
+	ss << entry.numberTowns <<  sep;
+	ss << entry.numberArtifacts << sep;
+	ss << entry.numberDwellings << sep;
+	ss << entry.armyStrength << sep;
+	ss << entry.totalExperience << sep;
+	ss << entry.income << sep;
+	ss << entry.mapExploredRatio << sep;
+	ss << entry.obeliskVisitedRatio << sep;
+	ss << entry.townBuiltRatio << sep;
+	ss << entry.hasGrail << sep;
+	ss << entry.score << sep;
+	ss << entry.maxHeroLevel << sep;
+	ss << entry.numBattlesNeutral << sep;
+	ss << entry.numBattlesPlayer << sep;
+	ss << entry.numWinBattlesNeutral << sep;
+	ss << entry.numWinBattlesPlayer << sep;
+	ss << entry.numHeroSurrendered << sep;
+	ss << entry.numHeroEscaped << sep;
+	ss << entry.eventCapturedTown << sep;
+	ss << entry.eventDefeatedStrongestHero << sep;
+	ss << entry.movementPointsUsed;
+	for(auto & resource : resources)
+		ss << sep << entry.resources[resource];
+	for(auto & resource : resources)
+		ss << sep << (entry.numMines.count(resource) ? entry.numMines.at(resource) : 0);
+	for(auto & resource : resources)
+		ss << sep << entry.spentResourcesForArmy[resource];
+	for(auto & resource : resources)
+		ss << sep << entry.spentResourcesForBuildings[resource];
+	for(auto & resource : resources)
+		ss << sep << entry.tradeVolume[resource];
+	ss << "\r\n";
+
+	return ss.str();
+}
+
+std::string StatisticDataSet::toCsv(std::string sep)
+{
+	std::string result = toCsvHeader(sep);
+
+	for(auto & entry : data)
+		result += toCsvRow(entry, sep);
+
+	return result;
+}
+
 std::string StatisticDataSet::writeCsv()
 {
 	const boost::filesystem::path outPath = VCMIDirs::get().userCachePath() / "statistic";
@@ -193,18 +231,9 @@ std::vector<const CGMine *> Statistic::getMines(const CGameState * gs, const Pla
 {
 	std::vector<const CGMine *> tmp;
 
-	std::vector<const CGObjectInstance *> ownedObjects;
-	for(const CGObjectInstance * obj : gs->map->objects)
-	{
-		if(obj && obj->tempOwner == ps->color)
-			ownedObjects.push_back(obj);
-	}
-	/// This is code from CPlayerSpecificInfoCallback::getMyObjects
-	/// I'm really need to find out about callback interface design...
-
-	for(const auto * object : ownedObjects)
+	// player state keeps list of owned objects up to date as packs are applied, so there is no need to scan entire map
+	for(const auto * object : ps->getOwnedObjects())
 	{
-		//Mines
 		if ( object->ID == Obj::MINE )
 		{
 			const auto * mine = dynamic_cast<const CGMine *>(object);
@@ -290,7 +319,7 @@ float Statistic::getMapExploredRatio(const CGameState * gs, PlayerColor player)
 		for(int y = 0; y < gs->map->height; ++y)
 			for(int x = 0; x < gs->map->width; ++x)
 			{
-				TerrainTile tile = gs->map->getTile(int3(x, y, layer));
+				const TerrainTile & tile = gs->map->getTile(int3(x, y, layer));
 
 				if(tile.blocked && (!tile.visitable))
 					continue;
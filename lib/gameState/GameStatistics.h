@@ -105,10 +105,15 @@ class DLL_LINKAGE StatisticDataSet
 {
 public:
     void add(StatisticDataSetEntry entry);
+	/// Removes entries of all days before specified one, to limit memory use and size of saved games in long games
+	void removeDaysBefore(int day);
 	static StatisticDataSetEntry createEntry(const PlayerState * ps, const CGameState * gs);
     std::string toCsv(std::string sep);
     std::string writeCsv();
 
+	static std::string toCsvHeader(const std::string & sep);
+	static std::string toCsvRow(const StatisticDataSetEntry & entry, const std::string & sep);
+
 	struct PlayerAccumulatedValueStorage // holds some actual values needed for stats
 	{
 		int numBattlesNeutral;
@@ -51,6 +51,23 @@ void CBasicLogConfigurator::configure()
 		}
 		CLogger::getGlobalLogger()->clearTargets();
 
+		// Optionally route all targets through background thread
+		std::unique_ptr<CLogAsyncTarget> asyncTarget;
+		const JsonNode & asyncNode = loggingNode["async"];
+		if(asyncNode["enabled"].Bool())
+		{
+			auto policy = asyncNode["overflowPolicy"].String() == "block" ? CLogAsyncTarget::EOverflowPolicy::BLOCK : CLogAsyncTarget::EOverflowPolicy::DROP;
+			asyncTarget = std::make_unique<CLogAsyncTarget>(asyncNode["capacity"].Integer(), policy);
+		}
+
+		const auto & addTarget = [&asyncTarget](std::unique_ptr<ILogTarget> && target)
+		{
+			if(asyncTarget)
+				asyncTarget->addTarget(std::move(target));
+			else
+				CLogger::getGlobalLogger()->addTarget(std::move(target));
+		};
+
 		// Add console target
 		auto consoleTarget = std::make_unique<CLogConsoleTarget>(console);
 		const JsonNode & consoleNode = loggingNode["console"];
@@ -77,7 +94,7 @@ void CBasicLogConfigurator::configure()
 			}
 			consoleTarget->setColorMapping(colorMapping);
 		}
-		CLogger::getGlobalLogger()->addTarget(std::move(consoleTarget));
+		addTarget(std::move(consoleTarget));
 
 		// Add file target
 		auto fileTarget = std::make_unique<CLogFileTarget>(filePath, appendToLogFile);
@@ -87,7 +104,10 @@ void CBasicLogConfigurator::configure()
 			const JsonNode & fileFormatNode = fileNode["format"];
 			if(!fileFormatNode.isNull()) fileTarget->setFormatter(CLogFormatter(fileFormatNode.String()));
 		}
-		CLogger::getGlobalLogger()->addTarget(std::move(fileTarget));
+		addTarget(std::move(fileTarget));
+
+		if(asyncTarget)
+			CLogger::getGlobalLogger()->addTarget(std::move(asyncTarget));
 		appendToLogFile = true;
 	}
 	catch(const std::exception & e)
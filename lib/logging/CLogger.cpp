@@ -173,7 +173,9 @@ const CLoggerDomain & CLogger::getDomain() const { return domain; }
 void CLogger::addTarget(std::unique_ptr<ILogTarget> && target)
 {
 	TLockGuard _(mx);
-	targets.push_back(std::move(target));
+	auto newTargets = targets ? std::make_shared<TargetsList>(*targets) : std::make_shared<TargetsList>();
+	newTargets->push_back(std::move(target));
+	std::atomic_store(&targets, std::shared_ptr<const TargetsList>(newTargets));
 }
 
 ELogLevel::ELogLevel CLogger::getEffectiveLevel() const
@@ -188,16 +190,22 @@ ELogLevel::ELogLevel CLogger::getEffectiveLevel() const
 
 void CLogger::callTargets(const LogRecord & record) const
 {
-	TLockGuard _(mx);
+	// targets are thread-safe on their own, so no lock is held while writing
 	for(const CLogger * logger = this; logger != nullptr; logger = logger->parent)
-		for(const auto & target : logger->targets)
+	{
+		auto loggerTargets = std::atomic_load(&logger->targets);
+		if(!loggerTargets)
+			continue;
+
+		for(const auto & target : *loggerTargets)
 			target->write(record);
+	}
 }
 
 void CLogger::clearTargets()
 {
 	TLockGuard _(mx);
-	targets.clear();
+	std::atomic_store(&targets, std::shared_ptr<const TargetsList>());
 }
 
 bool CLogger::isDebugEnabled() const { return getEffectiveLevel() <= ELogLevel::DEBUG; }
@@ -446,6 +454,153 @@ CLogFileTarget::~CLogFileTarget()
 	file.close();
 }
 
+CLogAsyncTarget::CLogAsyncTarget(size_t capacity, EOverflowPolicy policy)
+	: policy(policy)
+	, enqueuePosition(0)
+	, dequeuePosition(0)
+	, droppedRecords(0)
+	, reportedDroppedRecords(0)
+	, terminating(false)
+{
+	size_t actualCapacity = 2;
+	while(actualCapacity < capacity)
+		actualCapacity *= 2;
+
+	mask = actualCapacity - 1;
+	slots = std::make_unique<Slot[]>(actualCapacity);
+	for(size_t i = 0; i < actualCapacity; ++i)
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+
+	thread = boost::thread(&CLogAsyncTarget::run, this);
+}
+
+CLogAsyncTarget::~CLogAsyncTarget()
+{
+	terminating = true;
+	wakeup.notify_one();
+	thread.join();
+}
+
+void CLogAsyncTarget::addTarget(std::unique_ptr<ILogTarget> && target)
+{
+	TLockGuard _(wakeupMutex);
+	targets.push_back(std::move(target));
+}
+
+uint64_t CLogAsyncTarget::getDroppedRecords() const
+{
+	return droppedRecords.load(std::memory_order_relaxed);
+}
+
+void CLogAsyncTarget::write(const LogRecord & record)
+{
+	while(!tryPush(record))
+	{
+		if(policy == EOverflowPolicy::DROP)
+		{
+			droppedRecords.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		wakeup.notify_one();
+		boost::this_thread::yield();
+	}
+	wakeup.notify_one();
+}
+
+bool CLogAsyncTarget::tryPush(const LogRecord & record)
+{
+	// bounded multi-producer queue, see D. Vyukov "Bounded MPMC queue"
+	size_t position = enqueuePosition.load(std::memory_order_relaxed);
+	while(true)
+	{
+		Slot & slot = slots[position & mask];
+		size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+		if(difference == 0)
+		{
+			if(enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				slot.record = record;
+				slot.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if(difference < 0)
+		{
+			return false; // buffer is full
+		}
+		else
+		{
+			position = enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool CLogAsyncTarget::tryPop(LogRecord & record)
+{
+	// only background thread reads from the queue
+	Slot & slot = slots[dequeuePosition & mask];
+	size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+	if(sequence != dequeuePosition + 1)
+		return false;
+
+	record = std::move(slot.record);
+	slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+	dequeuePosition += 1;
+	return true;
+}
+
+void CLogAsyncTarget::writeToTargets(const LogRecord & record)
+{
+	for(const auto & target : targets)
+		target->write(record);
+}
+
+void CLogAsyncTarget::reportDroppedRecords()
+{
+	uint64_t dropped = getDroppedRecords();
+	if(dropped == reportedDroppedRecords)
+		return;
+
+	std::string message = std::to_string(dropped - reportedDroppedRecords) + " log records were dropped due to log buffer overflow";
+	writeToTargets(LogRecord(CLoggerDomain(CLoggerDomain::DOMAIN_GLOBAL), ELogLevel::WARN, message));
+	reportedDroppedRecords = dropped;
+}
+
+void CLogAsyncTarget::run()
+{
+	setThreadName("asyncLogger");
+
+	LogRecord record;
+	while(true)
+	{
+		bool terminationRequested = terminating;
+
+		{
+			TLockGuard _(wakeupMutex);
+			while(tryPop(record))
+				writeToTargets(record);
+			reportDroppedRecords();
+		}
+
+		if(terminationRequested)
+			return;
+
+		std::unique_lock lock(wakeupMutex);
+		// producers notify without taking the lock, so use timeout to avoid missing wakeups
+		wakeup.wait_for(lock, std::chrono::milliseconds(50));
+	}
+}
+
+LogRecord::LogRecord()
+	: domain(CLoggerDomain::DOMAIN_GLOBAL),
+	level(ELogLevel::NOT_SET)
+{
+}
+
 LogRecord::LogRecord(const CLoggerDomain & domain, ELogLevel::ELogLevel level, const std::string & message)
 	: domain(domain),
 	level(level),
@@ -11,6 +11,8 @@
 
 #include "../CConsoleHandler.h"
 
+#include <condition_variable>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 class CLogger;
@@ -73,10 +75,13 @@ private:
 	inline ELogLevel::ELogLevel getEffectiveLevel() const; /// Returns the log level applied on this logger whether directly or indirectly.
 	inline void callTargets(const LogRecord & record) const;
 
+	using TargetsList = std::vector<std::shared_ptr<ILogTarget>>;
+
 	CLoggerDomain domain;
 	CLogger * parent;
 	ELogLevel::ELogLevel level;
-	std::vector<std::unique_ptr<ILogTarget> > targets;
+	/// Immutable list of targets, replaced as a whole on modification so that logging threads can read it without locking
+	std::shared_ptr<const TargetsList> targets;
 	mutable std::mutex mx;
 	static std::recursive_mutex smx;
 };
@@ -107,6 +112,7 @@ private:
 /// The struct LogRecord holds the log message and additional logging information.
 struct DLL_LINKAGE LogRecord
 {
+	LogRecord();
 	LogRecord(const CLoggerDomain & domain, ELogLevel::ELogLevel level, const std::string & message);
 
 	CLoggerDomain domain;
@@ -219,4 +225,59 @@ private:
 	mutable std::mutex mx;
 };
 
+/// This target forwards log records to the wrapped targets from a dedicated background thread.
+/// Producers only copy the record into a bounded lock-free ring buffer, so logging threads never wait
+/// on formatting or file I/O. When the buffer is full records are either dropped or producer waits, according to policy.
+class DLL_LINKAGE CLogAsyncTarget : public ILogTarget
+{
+public:
+	enum class EOverflowPolicy
+	{
+		DROP,
+		BLOCK
+	};
+
+	/// Capacity is rounded up to the nearest power of two
+	CLogAsyncTarget(size_t capacity, EOverflowPolicy policy);
+	~CLogAsyncTarget();
+
+	/// Adds target that will receive log records from background thread. Must be called before logging starts.
+	void addTarget(std::unique_ptr<ILogTarget> && target);
+
+	/// Returns total number of records that were dropped due to buffer overflow
+	uint64_t getDroppedRecords() const;
+
+	void write(const LogRecord & record) override;
+
+private:
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		LogRecord record;
+	};
+
+	bool tryPush(const LogRecord & record);
+	bool tryPop(LogRecord & record);
+	void writeToTargets(const LogRecord & record);
+	void reportDroppedRecords();
+	void run();
+
+	std::unique_ptr<Slot[]> slots;
+	size_t mask;
+	EOverflowPolicy policy;
+
+	std::atomic<size_t> enqueuePosition;
+	size_t dequeuePosition;
+
+	std::atomic<uint64_t> droppedRecords;
+	uint64_t reportedDroppedRecords;
+
+	std::vector<std::unique_ptr<ILogTarget>> targets;
+
+	std::atomic<bool> terminating;
+	std::mutex wakeupMutex;
+	std::condition_variable wakeup;
+	boost::thread thread;
+};
+
 VCMI_LIB_NAMESPACE_END
@@ -96,24 +96,12 @@ static int lowestSpeed(const CGHeroInstance * chi)
 
 ui32 CGHeroInstance::getTileMovementCost(const TerrainTile & dest, const TerrainTile & from, const TurnInfo * ti) const
 {
-	int64_t ret = GameConstants::BASE_MOVEMENT_COST;
-
 	//if there is road both on dest and src tiles - use src road movement cost
 	if(dest.roadType->getId() != Road::NO_ROAD && from.roadType->getId() != Road::NO_ROAD)
-	{
-		ret = from.roadType->movementCost;
-	}
-	else if(ti->nativeTerrain != from.terType->getId() &&//the terrain is not native
-			ti->nativeTerrain != ETerrainId::ANY_TERRAIN && //no special creature bonus
-			!ti->hasBonusOfType(BonusType::NO_TERRAIN_PENALTY, BonusSubtypeID(from.terType->getId()))) //no special movement bonus
-	{
+		return from.roadType->movementCost;
 
-		ret = VLC->terrainTypeHandler->getById(from.terType->getId())->moveCost;
-		ret -= ti->valOfBonuses(BonusType::ROUGH_TERRAIN_DISCOUNT);
-		if(ret < GameConstants::BASE_MOVEMENT_COST)
-			ret = GameConstants::BASE_MOVEMENT_COST;
-	}
-	return static_cast<ui32>(ret);
+	// terrain penalty, native terrain and movement bonuses are resolved in advance by TurnInfo
+	return ti->getTerrainMovementCost(from.terType->getId());
 }
 
 FactionID CGHeroInstance::getFaction() const
@@ -130,6 +130,46 @@ void CCastleEvent::serializeJson(JsonSerializeFormat & handler)
 	}
 }
 
+TileObjectList::TileObjectList(const TileObjectList & other)
+{
+	if(other.objects)
+		objects = std::make_unique<std::vector<CGObjectInstance *>>(*other.objects);
+}
+
+TileObjectList & TileObjectList::operator=(const TileObjectList & other)
+{
+	if(this == &other)
+		return *this;
+
+	if(other.objects)
+		objects = std::make_unique<std::vector<CGObjectInstance *>>(*other.objects);
+	else
+		objects.reset();
+	return *this;
+}
+
+void TileObjectList::push_back(CGObjectInstance * object)
+{
+	if(!objects)
+		objects = std::make_unique<std::vector<CGObjectInstance *>>();
+	objects->push_back(object);
+}
+
+bool TileObjectList::remove(const CGObjectInstance * object)
+{
+	if(!objects)
+		return false;
+
+	auto it = std::find(objects->begin(), objects->end(), object);
+	if(it == objects->end())
+		return false;
+
+	objects->erase(it);
+	if(objects->empty())
+		objects.reset();
+	return true;
+}
+
 TerrainTile::TerrainTile():
 	terType(nullptr),
 	riverType(VLC->riverTypeHandler->getById(River::NO_RIVER)),
@@ -244,12 +284,12 @@ void CMap::removeBlockVisTiles(CGObjectInstance * obj, bool total)
 				TerrainTile & curt = terrain[zVal][xVal][yVal];
 				if(total || obj->visitableAt(xVal, yVal))
 				{
-					curt.visitableObjects -= obj;
+					curt.visitableObjects.remove(obj);
 					curt.visitable = curt.visitableObjects.size();
 				}
 				if(total || obj->blockingAt(xVal, yVal))
 				{
-					curt.blockingObjects -= obj;
+					curt.blockingObjects.remove(obj);
 					curt.blocked = curt.blockingObjects.size();
 				}
 			}
@@ -293,12 +333,43 @@ void CMap::calculateGuardingGreaturePositions()
 		{
 			for(int y = 0; y < height; y++)
 			{
-				guardingCreaturePositions[z][x][y] = guardingCreaturePosition(int3(x, y, z));
+				updateGuardingCreatures(int3(x, y, z));
 			}
 		}
 	}
 }
 
+void CMap::updateGuardingCreaturePositions(const CGObjectInstance * obj)
+{
+	// object may affect guards of any tile within one tile from its area:
+	// either as a guard itself, or by changing from which directions its tiles can be entered
+	for(int x = obj->pos.x - obj->getWidth(); x <= obj->pos.x + 1; x++)
+	{
+		for(int y = obj->pos.y - obj->getHeight(); y <= obj->pos.y + 1; y++)
+		{
+			int3 tile(x, y, obj->pos.z);
+			if(isInTheMap(tile))
+				updateGuardingCreatures(tile);
+		}
+	}
+}
+
+void CMap::updateGuardingCreatures(const int3 & pos)
+{
+	guardingCreaturePositions[pos.z][pos.x][pos.y] = guardingCreaturePosition(pos);
+	guardingCreatures[pos.z][pos.x][pos.y] = calculateGuardingCreatures(pos);
+}
+
+const std::vector<CGObjectInstance *> & CMap::getGuardingCreatures(const int3 & pos) const
+{
+	static const std::vector<CGObjectInstance *> noGuards;
+
+	if(!isInTheMap(pos))
+		return noGuards;
+
+	return guardingCreatures[pos.z][pos.x][pos.y];
+}
+
 CGHeroInstance * CMap::getHero(HeroTypeID heroID)
 {
 	for(auto & elem : heroesOnMap)
@@ -422,6 +493,51 @@ int3 CMap::guardingCreaturePosition (int3 pos) const
 	return int3(-1, -1, -1);
 }
 
+std::vector<CGObjectInstance *> CMap::calculateGuardingCreatures(const int3 & pos) const
+{
+	std::vector<CGObjectInstance *> guards;
+
+	const TerrainTile & posTile = getTile(pos);
+	if (posTile.visitable)
+	{
+		for (CGObjectInstance* obj : posTile.visitableObjects)
+		{
+			if(obj->isBlockedVisitable())
+			{
+				if (obj->ID == Obj::MONSTER) // Monster
+					guards.push_back(obj);
+			}
+		}
+	}
+
+	int3 neighbour = pos - int3(1, 1, 0); // Start with top left.
+	for (int dx = 0; dx < 3; dx++)
+	{
+		for (int dy = 0; dy < 3; dy++)
+		{
+			if (isInTheMap(neighbour))
+			{
+				const auto & tile = getTile(neighbour);
+				if (tile.visitable && (tile.isWater() == posTile.isWater()))
+				{
+					for (CGObjectInstance* obj : tile.visitableObjects)
+					{
+						if (obj->ID == Obj::MONSTER  &&  checkForVisitableDir(neighbour, &posTile, pos)) // Monster being able to attack investigated tile
+						{
+							guards.push_back(obj);
+						}
+					}
+				}
+			}
+
+			neighbour.y++;
+		}
+		neighbour.y -= 3;
+		neighbour.x++;
+	}
+	return guards;
+}
+
 const CGObjectInstance * CMap::getObjectiveObjectFrom(const int3 & pos, Obj type)
 {
 	for (CGObjectInstance * object : getTile(pos).visitableObjects)
@@ -724,6 +840,7 @@ void CMap::initTerrain()
 {
 	terrain.resize(boost::extents[levels()][width][height]);
 	guardingCreaturePositions.resize(boost::extents[levels()][width][height]);
+	guardingCreatures.resize(boost::extents[levels()][width][height]);
 }
 
 CMapEditManager * CMap::getEditManager()
@@ -102,10 +102,15 @@ public:
 	bool canMoveBetween(const int3 &src, const int3 &dst) const;
 	bool checkForVisitableDir(const int3 & src, const TerrainTile * pom, const int3 & dst) const;
 	int3 guardingCreaturePosition (int3 pos) const;
+	/// Returns all monsters that will attack hero on specified tile, using precomputed guard index
+	const std::vector<CGObjectInstance *> & getGuardingCreatures(const int3 & pos) const;
 
 	void addBlockVisTiles(CGObjectInstance * obj);
 	void removeBlockVisTiles(CGObjectInstance * obj, bool total = false);
 	void calculateGuardingGreaturePositions();
+	/// Updates guard index on tiles that may be affected by placing, removing or moving specified object
+	/// Must be called after tiles of object have been updated, while object is still alive
+	void updateGuardingCreaturePositions(const CGObjectInstance * obj);
 
 	void addNewArtifactInstance(CArtifactSet & artSet);
 	void addNewArtifactInstance(ConstTransitivePtr<CArtifactInstance> art);
@@ -188,6 +193,12 @@ private:
 	/// a 3-dimensional array of terrain tiles, access is as follows: x, y, level. where level=1 is underground
 	boost::multi_array<TerrainTile, 3> terrain;
 
+	/// For every tile, all monsters that guard it. Not serialized, rebuilt on load
+	boost::multi_array<std::vector<CGObjectInstance *>, 3> guardingCreatures;
+
+	std::vector<CGObjectInstance *> calculateGuardingCreatures(const int3 & pos) const;
+	void updateGuardingCreatures(const int3 & pos);
+
 	si32 uidCounter; //TODO: initialize when loading an old map
 
 public:
@@ -226,6 +237,12 @@ public:
 
 		if (h.version >= Handler::Version::PER_MAP_GAME_SETTINGS)
 			h & *gameSettings;
+
+		if (!h.saving)
+		{
+			guardingCreatures.resize(boost::extents[levels()][width][height]);
+			calculateGuardingGreaturePositions();
+		}
 	}
 };
 
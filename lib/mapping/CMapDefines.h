@@ -89,6 +89,78 @@ public:
 	void serializeJson(JsonSerializeFormat & handler) override;
 };
 
+/// List of objects located on a single map tile. Vast majority of tiles contain no objects,
+/// so storage is allocated out-of-line only for non-empty lists and empty list occupies single pointer
+class DLL_LINKAGE TileObjectList
+{
+	std::unique_ptr<std::vector<CGObjectInstance *>> objects;
+
+public:
+	using value_type = CGObjectInstance *;
+	using const_iterator = CGObjectInstance * const *;
+	using iterator = const_iterator;
+
+	TileObjectList() = default;
+	TileObjectList(const TileObjectList & other);
+	TileObjectList(TileObjectList && other) noexcept = default;
+	TileObjectList & operator=(const TileObjectList & other);
+	TileObjectList & operator=(TileObjectList && other) noexcept = default;
+
+	bool empty() const
+	{
+		return objects == nullptr;
+	}
+
+	size_t size() const
+	{
+		return objects ? objects->size() : 0;
+	}
+
+	const_iterator begin() const
+	{
+		return objects ? objects->data() : nullptr;
+	}
+
+	const_iterator end() const
+	{
+		return begin() + size();
+	}
+
+	CGObjectInstance * operator[](size_t index) const
+	{
+		return (*objects)[index];
+	}
+
+	CGObjectInstance * front() const
+	{
+		return objects->front();
+	}
+
+	CGObjectInstance * back() const
+	{
+		return objects->back();
+	}
+
+	void push_back(CGObjectInstance * object);
+	/// Removes object from the list, returns false if object was not present
+	bool remove(const CGObjectInstance * object);
+
+	template <typename Handler>
+	void serialize(Handler & h)
+	{
+		// stored in same format as plain vector to keep compatibility with existing saves
+		std::vector<CGObjectInstance *> list(begin(), end());
+		h & list;
+
+		if (!h.saving)
+		{
+			objects.reset();
+			for(auto * object : list)
+				push_back(object);
+		}
+	}
+};
+
 /// The terrain tile describes the terrain type and the visual representation of the terrain.
 /// Furthermore the struct defines whether the tile is visitable or/and blocked and which objects reside in it.
 struct DLL_LINKAGE TerrainTile
@@ -119,8 +191,8 @@ struct DLL_LINKAGE TerrainTile
 	bool visitable;
 	bool blocked;
 
-	std::vector<CGObjectInstance *> visitableObjects;
-	std::vector<CGObjectInstance *> blockingObjects;
+	TileObjectList visitableObjects;
+	TileObjectList blockingObjects;
 
 	template <typename Handler>
 	void serialize(Handler & h)
@@ -49,6 +49,8 @@ public:
 	CMapInfo &operator=(const CMapInfo &other) = delete;
 
 	void mapInit(const std::string & fname);
+	/// Initializes map info using already loaded map header
+	void mapInit(const std::string & fname, std::unique_ptr<CMapHeader> header);
 	void saveInit(const ResourcePath & file);
 	void campaignInit();
 	void countPlayers();
@@ -15,6 +15,7 @@ VCMI_LIB_NAMESPACE_BEGIN
 NetworkConnection::NetworkConnection(INetworkConnectionListener & listener, const std::shared_ptr<NetworkSocket> & socket, const std::shared_ptr<NetworkContext> & context)
 	: socket(socket)
 	, timer(std::make_shared<NetworkTimer>(*context))
+	, strand(boost::asio::make_strand(*context))
 	, listener(listener)
 {
 	socket->set_option(boost::asio::ip::tcp::no_delay(true));
@@ -43,35 +44,48 @@ NetworkConnection::NetworkConnection(INetworkConnectionListener & listener, cons
 
 void NetworkConnection::start()
 {
-	heartbeat();
-	startReceiving();
+	boost::asio::dispatch(strand, [self = shared_from_this()]()
+	{
+		self->heartbeat();
+		self->startReceiving();
+	});
 }
 
 void NetworkConnection::startReceiving()
 {
+	if (relayTarget)
+	{
+		startRelayReceiving();
+		return;
+	}
+
 	boost::asio::async_read(*socket,
 							readBuffer,
 							boost::asio::transfer_exactly(messageHeaderSize),
-							[self = shared_from_this()](const auto & ec, const auto & endpoint) { self->onHeaderReceived(ec); });
+							boost::asio::bind_executor(strand, [self = shared_from_this()](const auto & ec, const auto & endpoint) { self->onHeaderReceived(ec); }));
 }
 
 void NetworkConnection::heartbeat()
 {
 	constexpr auto heartbeatInterval = std::chrono::seconds(10);
 
+	// heartbeat packets from relay itself would corrupt forwarded stream. Heartbeats of both sides are forwarded instead
+	if (relayTarget)
+		return;
+
 	timer->expires_after(heartbeatInterval);
-	timer->async_wait( [self = weak_from_this()](const auto & ec)
+	timer->async_wait(boost::asio::bind_executor(strand, [self = weak_from_this()](const auto & ec)
 	{
 		if (ec)
 			return;
 
 		auto locked = self.lock();
-		if (!locked)
+		if (!locked || locked->relayTarget)
 			return;
 
-		locked->sendPacket({});
+		locked->sendPacket(NetworkMessagePtr());
 		locked->heartbeat();
-	});
+	}));
 }
 
 void NetworkConnection::onHeaderReceived(const boost::system::error_code & ecHeader)
@@ -85,6 +99,13 @@ void NetworkConnection::onHeaderReceived(const boost::system::error_code & ecHea
 	if (readBuffer.size() < messageHeaderSize)
 		throw std::runtime_error("Failed to read header!");
 
+	// relay mode was enabled while we were waiting for this packet - forward it as is, together with its header
+	if (relayTarget)
+	{
+		startRelayReceiving();
+		return;
+	}
+
 	uint32_t messageSize;
 	readBuffer.sgetn(reinterpret_cast<char *>(&messageSize), sizeof(messageSize));
 
@@ -101,13 +122,14 @@ void NetworkConnection::onHeaderReceived(const boost::system::error_code & ecHea
 		return;
 	}
 
+	// payload is read directly into reusable buffer, bypassing intermediate stream buffer
+	receiveBuffer.resize(messageSize);
 	boost::asio::async_read(*socket,
-							readBuffer,
-							boost::asio::transfer_exactly(messageSize),
-							[self = shared_from_this(), messageSize](const auto & ecPayload, const auto & endpoint) { self->onPacketReceived(ecPayload, messageSize); });
+							boost::asio::buffer(receiveBuffer),
+							boost::asio::bind_executor(strand, [self = shared_from_this()](const auto & ecPayload, const auto & bytesReceived) { self->onPacketReceived(ecPayload); }));
 }
 
-void NetworkConnection::onPacketReceived(const boost::system::error_code & ec, uint32_t expectedPacketSize)
+void NetworkConnection::onPacketReceived(const boost::system::error_code & ec)
 {
 	if (ec)
 	{
@@ -115,53 +137,168 @@ void NetworkConnection::onPacketReceived(const boost::system::error_code & ec, u
 		return;
 	}
 
-	if (readBuffer.size() < expectedPacketSize)
+	listener.onPacketReceived(shared_from_this(), receiveBuffer);
+
+	if (receiveBuffer.capacity() > receiveBufferRetainedSize)
+		receiveBuffer = {};
+
+	if (receivingPaused)
+		return;
+
+	startReceiving();
+}
+
+void NetworkConnection::pauseReceiving()
+{
+	receivingPaused = true;
+}
+
+void NetworkConnection::resumeReceiving()
+{
+	boost::asio::dispatch(strand, [self = shared_from_this()]()
+	{
+		if (!self->receivingPaused)
+			return;
+
+		self->receivingPaused = false;
+		self->startReceiving();
+	});
+}
+
+void NetworkConnection::startRelay(const std::shared_ptr<INetworkConnection> & target)
+{
+	boost::asio::dispatch(strand, [self = shared_from_this(), target = std::dynamic_pointer_cast<NetworkConnection>(target)]()
+	{
+		self->relayTarget = target;
+		self->relayBuffer.resize(relayChunkSize);
+		self->relayStartTime = std::chrono::steady_clock::now();
+
+		// stop heartbeats, see heartbeat()
+		boost::system::error_code ec;
+		self->timer->cancel(ec);
+	});
+}
+
+void NetworkConnection::startRelayReceiving()
+{
+	// forward data that was received before switching to relay mode but not processed yet
+	if (readBuffer.size() != 0)
+	{
+		size_t bufferedBytes = readBuffer.size();
+		relayBuffer.resize(std::max<size_t>(bufferedBytes, relayChunkSize));
+		readBuffer.sgetn(reinterpret_cast<char *>(relayBuffer.data()), bufferedBytes);
+		onRelayDataReceived({}, bufferedBytes);
+		return;
+	}
+
+	relayBuffer.resize(relayChunkSize);
+	socket->async_read_some(boost::asio::buffer(relayBuffer), boost::asio::bind_executor(strand, [self = shared_from_this()](const auto & ec, size_t bytesReceived)
 	{
-		// FIXME: figure out what causes this. This should not be possible without error set
-		std::string errorMessage = "Failed to read packet! " + std::to_string(readBuffer.size()) + " bytes read, but " + std::to_string(expectedPacketSize) + " bytes expected!";
-		onError(errorMessage);
+		self->onRelayDataReceived(ec, bytesReceived);
+	}));
+}
+
+void NetworkConnection::onRelayDataReceived(const boost::system::error_code & ec, size_t bytesReceived)
+{
+	if (ec)
+	{
+		onError(ec.message());
+		return;
 	}
 
-	std::vector<std::byte> message(expectedPacketSize);
-	readBuffer.sgetn(reinterpret_cast<char *>(message.data()), expectedPacketSize);
-	listener.onPacketReceived(shared_from_this(), message);
+	if (!relayTarget)
+		return; // connection has been closed
 
-	startReceiving();
+	relayedBytes += bytesReceived;
+
+	// data is written through write queue of target, so it can not interleave with packets that target is still sending
+	// next chunk is only requested once this one was sent, so slow receiver limits reading speed of sender
+	auto data = std::make_shared<const std::vector<std::byte>>(relayBuffer.begin(), relayBuffer.begin() + bytesReceived);
+	relayTarget->queueRelayData(data, shared_from_this());
+}
+
+void NetworkConnection::onRelayDataSent(const boost::system::error_code & ec)
+{
+	if (ec)
+	{
+		onError(ec.message());
+		return;
+	}
+
+	startRelayReceiving();
 }
 
 void NetworkConnection::setAsyncWritesEnabled(bool on)
 {
+	std::lock_guard lock(writeMutex);
 	asyncWritesEnabled = on;
 }
 
 void NetworkConnection::sendPacket(const std::vector<std::byte> & message)
 {
 	std::lock_guard lock(writeMutex);
-	std::vector<std::byte> headerVector(sizeof(uint32_t));
-	uint32_t messageSize = message.size();
-	std::memcpy(headerVector.data(), &messageSize, sizeof(uint32_t));
 
 	// At the moment, vcmilobby *requires* async writes in order to handle multiple connections with different speeds and at optimal performance
 	// However server (and potentially - client) can not handle this mode and may shutdown either socket or entire asio service too early, before all writes are performed
 	if (asyncWritesEnabled)
 	{
+		// caller owns the message and may reuse it right away, so it must be copied until write is complete
+		queuePacket(message.empty() ? nullptr : std::make_shared<const std::vector<std::byte>>(message));
+	}
+	else
+		sendPacketImmediately(message);
+}
 
-		bool messageQueueEmpty = dataToSend.empty();
-		dataToSend.push_back(headerVector);
-		if (!message.empty())
-			dataToSend.push_back(message);
+void NetworkConnection::sendPacket(const NetworkMessagePtr & message)
+{
+	std::lock_guard lock(writeMutex);
 
-		if (messageQueueEmpty)
-			doSendData();
-		//else - data sending loop is still active and still sending previous messages
-	}
+	if (asyncWritesEnabled)
+		queuePacket(message);
+	else if (message)
+		sendPacketImmediately(*message);
 	else
+		sendPacketImmediately({});
+}
+
+void NetworkConnection::sendPacketImmediately(const std::vector<std::byte> & message)
+{
+	uint32_t messageSize = message.size();
+	std::array<boost::asio::const_buffer, 2> buffers = {
+		boost::asio::buffer(&messageSize, sizeof(messageSize)),
+		boost::asio::buffer(message)
+	};
+
+	boost::system::error_code ec;
+	boost::asio::write(*socket, buffers, ec);
+}
+
+void NetworkConnection::queuePacket(const NetworkMessagePtr & message)
+{
+	queueOutgoingPacket({message ? static_cast<uint32_t>(message->size()) : 0, message, nullptr});
+}
+
+void NetworkConnection::queueRelayData(const NetworkMessagePtr & data, const std::shared_ptr<NetworkConnection> & source)
+{
+	std::lock_guard lock(writeMutex);
+	queueOutgoingPacket({0, data, source});
+}
+
+void NetworkConnection::queueOutgoingPacket(OutgoingPacket && packet)
+{
+	bool messageQueueEmpty = dataToSend.empty();
+	dataToSend.push_back(std::move(packet));
+
+	// write must be started on connection strand. Any packets queued before that will be sent together with this one
+	if (messageQueueEmpty)
 	{
-		boost::system::error_code ec;
-		boost::asio::write(*socket, boost::asio::buffer(headerVector), ec );
-		if (!message.empty())
-			boost::asio::write(*socket, boost::asio::buffer(message), ec );
+		boost::asio::post(strand, [self = shared_from_this()]()
+		{
+			std::lock_guard lock(self->writeMutex);
+			self->doSendData();
+		});
 	}
+	//else - data sending loop is still active. New packet will be sent together with all other packets queued until then
 }
 
 void NetworkConnection::doSendData()
@@ -169,16 +306,38 @@ void NetworkConnection::doSendData()
 	if (dataToSend.empty())
 		throw std::runtime_error("Attempting to sent data but there is no data to send!");
 
-	boost::asio::async_write(*socket, boost::asio::buffer(dataToSend.front()), [self = shared_from_this()](const auto & error, const auto & )
+	// gather all queued packets into a single write. Elements of deque are not relocated on push_back, so buffers remain valid
+	std::vector<boost::asio::const_buffer> buffers;
+	buffers.reserve(dataToSend.size() * 2);
+	for (const auto & packet : dataToSend)
+	{
+		if (!packet.relaySource)
+			buffers.push_back(boost::asio::buffer(&packet.header, sizeof(packet.header)));
+		if (packet.payload && !packet.payload->empty())
+			buffers.push_back(boost::asio::buffer(*packet.payload));
+	}
+	packetsInFlight = dataToSend.size();
+
+	boost::asio::async_write(*socket, buffers, boost::asio::bind_executor(strand, [self = shared_from_this()](const auto & error, const auto & )
 	{
 		self->onDataSent(error);
-	});
+	}));
 }
 
 void NetworkConnection::onDataSent(const boost::system::error_code & ec)
 {
 	std::lock_guard lock(writeMutex);
-	dataToSend.pop_front();
+
+	// let relays request next chunk of data. This is done on their own strands
+	for (size_t i = 0; i < packetsInFlight; ++i)
+	{
+		if (dataToSend[i].relaySource)
+			boost::asio::post(dataToSend[i].relaySource->strand, [source = dataToSend[i].relaySource, ec]() { source->onRelayDataSent(ec); });
+	}
+
+	dataToSend.erase(dataToSend.begin(), dataToSend.begin() + packetsInFlight);
+	packetsInFlight = 0;
+
 	if (ec)
 	{
 		onError(ec.message());
@@ -192,16 +351,35 @@ void NetworkConnection::onDataSent(const boost::system::error_code & ec)
 void NetworkConnection::onError(const std::string & message)
 {
 	listener.onDisconnected(shared_from_this(), message);
-	close();
+	closeOnStrand();
 }
 
 void NetworkConnection::close()
+{
+	// socket and relay state may only be accessed on connection strand, while this method can be called from any thread
+	boost::asio::dispatch(strand, [self = shared_from_this()]()
+	{
+		self->closeOnStrand();
+	});
+}
+
+void NetworkConnection::closeOnStrand()
 {
 	boost::system::error_code ec;
 	socket->close(ec);
 	timer->cancel(ec);
 
 	//NOTE: ignoring error code, intended
+
+	if (relayTarget)
+	{
+		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - relayStartTime);
+		double megabytesPerSecond = duration.count() == 0 ? 0 : relayedBytes / 1024.0 / 1024.0 / (duration.count() / 1000.0);
+		logNetwork->info("Relay closed: %d bytes forwarded in %d ms (%.2f MB/s)", relayedBytes, duration.count(), megabytesPerSecond);
+
+		// breaks ownership cycle between two sides of relay
+		relayTarget.reset();
+	}
 }
 
 VCMI_LIB_NAMESPACE_END
@@ -17,25 +17,59 @@ class NetworkConnection final : public INetworkConnection, public std::enable_sh
 {
 	static const int messageHeaderSize = sizeof(uint32_t);
 	static const int messageMaxSize = 64 * 1024 * 1024; // arbitrary size to prevent potential massive allocation if we receive garbage input
+	static const int relayChunkSize = 64 * 1024;
+	static const int receiveBufferRetainedSize = 1024 * 1024; // buffers above this size are released after use to avoid keeping memory of rare huge packets
+
+	/// Single queued packet. Payload is shared so the same message can be queued on multiple connections without copying
+	struct OutgoingPacket
+	{
+		uint32_t header;
+		NetworkMessagePtr payload;
+		/// Set for raw data forwarded by relay connection. Such data is written without header and relay is notified once it has been sent
+		std::shared_ptr<NetworkConnection> relaySource;
+	};
+
+	std::deque<OutgoingPacket> dataToSend;
+	/// Number of packets from the front of dataToSend that are currently being written by asio
+	size_t packetsInFlight = 0;
 
-	std::list<std::vector<std::byte>> dataToSend;
 	std::shared_ptr<NetworkSocket> socket;
 	std::shared_ptr<NetworkTimer> timer;
+	/// All operations on socket and timer are executed through this strand, so connection can be used when network runs on multiple threads
+	NetworkStrand strand;
 	std::mutex writeMutex;
 
 	NetworkBuffer readBuffer;
+	/// Reused between packets to avoid allocation for every received message
+	std::vector<std::byte> receiveBuffer;
 	INetworkConnectionListener & listener;
 	bool asyncWritesEnabled = false;
+	bool receivingPaused = false;
+
+	/// Connection to which all incoming data is forwarded in relay mode
+	std::shared_ptr<NetworkConnection> relayTarget;
+	std::vector<std::byte> relayBuffer;
+	uint64_t relayedBytes = 0;
+	std::chrono::steady_clock::time_point relayStartTime;
 
 	void heartbeat();
 	void onError(const std::string & message);
+	void closeOnStrand();
 
 	void startReceiving();
 	void onHeaderReceived(const boost::system::error_code & ec);
-	void onPacketReceived(const boost::system::error_code & ec, uint32_t expectedPacketSize);
+	void onPacketReceived(const boost::system::error_code & ec);
 
 	void doSendData();
 	void onDataSent(const boost::system::error_code & ec);
+	void queuePacket(const NetworkMessagePtr & message);
+	void queueOutgoingPacket(OutgoingPacket && packet);
+	void queueRelayData(const NetworkMessagePtr & data, const std::shared_ptr<NetworkConnection> & source);
+	void sendPacketImmediately(const std::vector<std::byte> & message);
+
+	void startRelayReceiving();
+	void onRelayDataReceived(const boost::system::error_code & ec, size_t bytesReceived);
+	void onRelayDataSent(const boost::system::error_code & ec);
 
 public:
 	NetworkConnection(INetworkConnectionListener & listener, const std::shared_ptr<NetworkSocket> & socket, const std::shared_ptr<NetworkContext> & context);
@@ -43,7 +77,11 @@ public:
 	void start();
 	void close() override;
 	void sendPacket(const std::vector<std::byte> & message) override;
+	void sendPacket(const NetworkMessagePtr & message) override;
 	void setAsyncWritesEnabled(bool on) override;
+	void startRelay(const std::shared_ptr<INetworkConnection> & target) override;
+	void pauseReceiving() override;
+	void resumeReceiving() override;
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -13,6 +13,8 @@
 #include "NetworkServer.h"
 #include "NetworkConnection.h"
 
+#include "../CThreadHelper.h"
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 std::unique_ptr<INetworkHandler> INetworkHandler::createHandler()
@@ -59,9 +61,28 @@ void NetworkHandler::connectToRemote(INetworkClientListener & listener, const st
 }
 
 void NetworkHandler::run()
+{
+	run(1);
+}
+
+void NetworkHandler::run(size_t threadsCount)
 {
 	boost::asio::executor_work_guard<decltype(io->get_executor())> work{io->get_executor()};
+
+	std::vector<boost::thread> threads;
+	for (size_t i = 1; i < threadsCount; ++i)
+	{
+		threads.emplace_back([this, i]()
+		{
+			setThreadName("network_" + std::to_string(i));
+			io->run();
+		});
+	}
+
 	io->run();
+
+	for (auto & thread : threads)
+		thread.join();
 }
 
 void NetworkHandler::createTimer(INetworkTimerListener & listener, std::chrono::milliseconds duration)
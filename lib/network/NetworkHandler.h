@@ -25,6 +25,7 @@ public:
 	void createTimer(INetworkTimerListener & listener, std::chrono::milliseconds duration) override;
 
 	void run() override;
+	void run(size_t threadsCount) override;
 	void stop() override;
 };
 
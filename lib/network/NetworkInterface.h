@@ -11,14 +11,30 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Immutable message that can be queued for sending on multiple connections without copying
+using NetworkMessagePtr = std::shared_ptr<const std::vector<std::byte>>;
+
 /// Base class for connections with other services, either incoming or outgoing
 class DLL_LINKAGE INetworkConnection : boost::noncopyable
 {
 public:
 	virtual ~INetworkConnection() = default;
+	/// Sends copy of provided message
 	virtual void sendPacket(const std::vector<std::byte> & message) = 0;
+	/// Sends shared message. Message must not be modified after this call
+	virtual void sendPacket(const NetworkMessagePtr & message) = 0;
 	virtual void setAsyncWritesEnabled(bool on) = 0;
 	virtual void close() = 0;
+
+	/// Switches connection into relay mode in which all incoming data is forwarded to target connection as is,
+	/// without splitting it into packets. Relay mode can not be disabled and lasts until connection is closed
+	virtual void startRelay(const std::shared_ptr<INetworkConnection> & target) = 0;
+
+	/// Stops reading of incoming data once currently received packet has been processed.
+	/// Must only be called from onPacketReceived callback of this connection
+	virtual void pauseReceiving() = 0;
+	/// Resumes reading of incoming data, as relayed data if relay mode has been started in meantime. Can be called from any thread
+	virtual void resumeReceiving() = 0;
 };
 
 using NetworkConnectionPtr = std::shared_ptr<INetworkConnection>;
@@ -101,6 +117,10 @@ public:
 
 	/// Starts network processing on this thread. Does not returns until networking processing has been terminated
 	virtual void run() = 0;
+
+	/// Starts network processing on this thread and on (threadsCount - 1) additional threads. Does not returns until networking processing has been terminated
+	/// Callbacks of a single connection are never executed concurrently, however callbacks of different connections and timers may be called from different threads at the same time
+	virtual void run(size_t threadsCount) = 0;
 	virtual void stop() = 0;
 };
 
@@ -41,7 +41,10 @@ void NetworkServer::connectionAccepted(std::shared_ptr<NetworkSocket> upcomingCo
 
 	logNetwork->info("We got a new connection! :)");
 	auto connection = std::make_shared<NetworkConnection>(*this, upcomingConnection, io);
-	connections.insert(connection);
+	{
+		std::lock_guard lock(connectionsMutex);
+		connections.insert(connection);
+	}
 	connection->start();
 	listener.onNewConnection(connection);
 	startAsyncAccept();
@@ -50,11 +53,15 @@ void NetworkServer::connectionAccepted(std::shared_ptr<NetworkSocket> upcomingCo
 void NetworkServer::onDisconnected(const std::shared_ptr<INetworkConnection> & connection, const std::string & errorMessage)
 {
 	logNetwork->info("Connection lost! Reason: %s", errorMessage);
-	if (connections.count(connection))
+
+	bool connectionRemoved = false;
 	{
-		connections.erase(connection);
-		listener.onDisconnected(connection, errorMessage);
+		std::lock_guard lock(connectionsMutex);
+		connectionRemoved = connections.erase(connection) != 0;
 	}
+
+	if (connectionRemoved)
+		listener.onDisconnected(connection, errorMessage);
 }
 
 void NetworkServer::onPacketReceived(const std::shared_ptr<INetworkConnection> & connection, const std::vector<std::byte> & message)
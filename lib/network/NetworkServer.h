@@ -18,6 +18,7 @@ class NetworkServer : public INetworkConnectionListener, public INetworkServer
 	std::shared_ptr<NetworkContext> io;
 	std::shared_ptr<NetworkAcceptor> acceptor;
 	std::set<std::shared_ptr<INetworkConnection>> connections;
+	std::mutex connectionsMutex;
 
 	INetworkServerListener & listener;
 
@@ -965,7 +965,6 @@ void FoWChange::applyGs(CGameState *gs)
 
 	if (mode == ETileVisibility::HIDDEN) //do not hide too much
 	{
-		std::unordered_set<int3> tilesRevealed;
 		for (auto & elem : gs->map->objects)
 		{
 			const CGObjectInstance *o = elem;
@@ -978,13 +977,11 @@ void FoWChange::applyGs(CGameState *gs)
 				case Obj::TOWN:
 				case Obj::ABANDONED_MINE:
 					if(vstd::contains(team->players, o->tempOwner)) //check owned observators
-						gs->getTilesInRange(tilesRevealed, o->getSightCenter(), o->getSightRadius(), ETileVisibility::HIDDEN, o->tempOwner);
+						gs->revealTilesInRange(fogOfWarMap, o->getSightCenter(), o->getSightRadius());
 					break;
 				}
 			}
 		}
-		for(const int3 & t : tilesRevealed) //probably not the most optimal solution ever
-			fogOfWarMap[t.z][t.x][t.y] = 1;
 	}
 }
 
@@ -1028,8 +1025,10 @@ void ChangeObjPos::applyGs(CGameState *gs)
 		return;
 	}
 	gs->map->removeBlockVisTiles(obj);
+	gs->map->updateGuardingCreaturePositions(obj);
 	obj->pos = nPos + obj->getVisitableOffset();
 	gs->map->addBlockVisTiles(obj);
+	gs->map->updateGuardingCreaturePositions(obj);
 }
 
 void ChangeObjectVisitors::applyGs(CGameState *gs)
@@ -1225,8 +1224,8 @@ void RemoveObject::applyGs(CGameState *gs)
 	}
 
 	gs->map->instanceNames.erase(obj->instanceName);
+	gs->map->updateGuardingCreaturePositions(obj);
 	gs->map->objects[objectID.getNum()].dellNull();
-	gs->map->calculateGuardingGreaturePositions();//FIXME: excessive, update only affected tiles
 }
 
 static int getDir(const int3 & src, const int3 & dst)
@@ -1462,7 +1461,7 @@ void NewObject::applyGs(CGameState *gs)
 
 	gs->map->objects.emplace_back(newObject);
 	gs->map->addBlockVisTiles(newObject);
-	gs->map->calculateGuardingGreaturePositions();
+	gs->map->updateGuardingCreaturePositions(newObject);
 
 	logGlobal->debug("Added object id=%d; name=%s", newObject->id, newObject->getObjectName());
 }
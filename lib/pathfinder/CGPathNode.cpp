@@ -60,6 +60,15 @@ CPathsInfo::CPathsInfo(const int3 & Sizes, const CGHeroInstance * hero_)
 
 CPathsInfo::~CPathsInfo() = default;
 
+void CPathsInfo::reset(const CGHeroInstance * hero_)
+{
+	hero = hero_;
+
+	// pathfinder initializes only layers that are usable by current hero, so nodes left from previous run must be cleared
+	for(auto * node = nodes.data(); node != nodes.data() + nodes.num_elements(); ++node)
+		node->reset();
+}
+
 const CGPathNode * CPathsInfo::getPathInfo(const int3 & tile) const
 {
 	assert(vstd::iswithin(tile.x, 0, sizes.x));
@@ -192,6 +192,8 @@ struct DLL_LINKAGE CPathsInfo
 
 	CPathsInfo(const int3 & Sizes, const CGHeroInstance * hero_);
 	~CPathsInfo();
+	/// Clears all nodes so this storage can be reused for another pathfinding run without reallocation
+	void reset(const CGHeroInstance * hero_);
 	const CGPathNode * getPathInfo(const int3 & tile) const;
 	bool getPath(CGPath & out, const int3 & dst) const;
 	const CGPathNode * getNode(const int3 & coord) const;
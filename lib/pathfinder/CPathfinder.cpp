@@ -17,6 +17,7 @@
 
 #include "../gameState/CGameState.h"
 #include "../CPlayerState.h"
+#include "../TraceProfiler.h"
 #include "../TerrainHandler.h"
 #include "../mapObjects/CGHeroInstance.h"
 #include "../mapObjects/CGTownInstance.h"
@@ -101,6 +102,8 @@ CGPathNode * CPathfinder::topAndPop()
 
 void CPathfinder::calculatePaths()
 {
+	VCMI_PROFILE_ZONE("CPathfinder::calculatePaths");
+
 	//logGlobal->info("Calculating paths for hero %s (address  %d) of player %d", hero->name, hero , hero->tempOwner);
 
 	//initial tile - set cost on 0 and add to the queue
@@ -126,6 +129,12 @@ void CPathfinder::calculatePaths()
 
 	std::vector<CGPathNode *> neighbourNodes;
 
+	const std::unordered_set<int3> * targetTiles = config->options.targetTiles && !config->options.targetTiles->empty() ? config->options.targetTiles.get() : nullptr;
+	std::unordered_set<int3> reachedTargets;
+	size_t targetsToReach = targetTiles ? targetTiles->size() : 0;
+	if(config->options.targetTilesToReach != 0)
+		vstd::amin(targetsToReach, config->options.targetTilesToReach);
+
 	while(!pq.empty())
 	{
 		counter++;
@@ -134,6 +143,16 @@ void CPathfinder::calculatePaths()
 		source.setNode(gamestate, node);
 		source.node->locked = true;
 
+		// node is final once it leaves the queue, so search can stop when all required targets are reached
+		// only layers on which hero can end movement are considered, same as in CPathsInfo::getNode
+		bool isTargetLayer = node->layer == EPathfindingLayer::LAND || node->layer == EPathfindingLayer::SAIL;
+		if(targetTiles && isTargetLayer && targetTiles->count(node->coord))
+		{
+			reachedTargets.insert(node->coord);
+			if(reachedTargets.size() >= targetsToReach)
+				break;
+		}
+
 		int movement = source.node->moveRemains;
 		uint8_t turn = source.node->turns;
 		float cost = source.node->getCost();
@@ -234,6 +253,11 @@ void CPathfinder::calculatePaths()
 		}
 	} //queue loop
 
+	// after early exit queue may still contain nodes that must not keep references to it
+	for(auto * node : pq)
+		node->pq = nullptr;
+	pq.clear();
+
 	logAi->trace("CPathfinder finished with %s iterations", std::to_string(counter));
 }
 
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include "../int3.h"
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 class INodeStorage;
@@ -85,6 +87,16 @@ struct DLL_LINKAGE PathfinderOptions
 	/// </summary>
 	bool allowLayerTransitioningAfterBattle;
 
+	/// If set and not empty, pathfinder stops as soon as paths to targetTilesToReach of these tiles are found.
+	/// Since nodes are expanded in order of their cost, found paths are optimal and reached targets are the nearest ones.
+	/// Paths to tiles that are further away than last reached target are incomplete or missing
+	/// Target is reached only on land or sail layer, same as nodes returned by CPathsInfo::getNode
+	/// Set is shared, so pathfinders of several heroes can search for the same targets without copying it
+	std::shared_ptr<const std::unordered_set<int3>> targetTiles;
+
+	/// Number of target tiles that must be reached before search stops. 0 = all target tiles
+	size_t targetTilesToReach;
+
 	PathfinderOptions(const CGameInfoCallback * callback);
 };
 
@@ -35,6 +35,21 @@ TurnInfo::BonusCache::BonusCache(const TConstBonusListPtr & bl)
 	pathfindingVal = bl->valOfBonuses(Selector::type()(BonusType::ROUGH_TERRAIN_DISCOUNT));
 }
 
+void TurnInfo::BonusCache::updateTerrainMovementCost(TerrainId nativeTerrain)
+{
+	terrainMovementCost.resize(VLC->terrainTypeHandler->objects.size());
+
+	for(const auto & terrain : VLC->terrainTypeHandler->objects)
+	{
+		int cost = GameConstants::BASE_MOVEMENT_COST;
+
+		if(nativeTerrain != terrain->getId() && nativeTerrain != ETerrainId::ANY_TERRAIN && !noTerrainPenalty.count(terrain->getId()))
+			cost = std::max<int>(GameConstants::BASE_MOVEMENT_COST, terrain->moveCost - pathfindingVal);
+
+		terrainMovementCost.at(terrain->getIndex()) = cost;
+	}
+}
+
 TurnInfo::TurnInfo(const CGHeroInstance * Hero, const int turn):
 	hero(Hero),
 	maxMovePointsLand(-1),
@@ -44,6 +59,7 @@ TurnInfo::TurnInfo(const CGHeroInstance * Hero, const int turn):
 	bonuses = hero->getAllBonuses(Selector::days(turn), Selector::all, "");
 	bonusCache = std::make_unique<BonusCache>(bonuses);
 	nativeTerrain = hero->getNativeTerrain();
+	bonusCache->updateTerrainMovementCost(nativeTerrain);
 }
 
 bool TurnInfo::isLayerAvailable(const EPathfindingLayer & layer) const
@@ -142,6 +158,7 @@ void TurnInfo::updateHeroBonuses(BonusType type, const CSelector& sel) const
 		break;
 	case BonusType::ROUGH_TERRAIN_DISCOUNT:
 		bonusCache->pathfindingVal = bonuses->valOfBonuses(Selector::type()(BonusType::ROUGH_TERRAIN_DISCOUNT));
+		bonusCache->updateTerrainMovementCost(nativeTerrain);
 		break;
 	default:
 		bonuses = hero->getAllBonuses(Selector::days(turn), Selector::all, "");
@@ -29,7 +29,12 @@ struct DLL_LINKAGE TurnInfo
 		int waterWalkingVal;
 		int pathfindingVal;
 
+		/// Cost of leaving tile of each terrain type when not moving along the road, indexed by terrain ID
+		/// Native terrain, terrain penalty immunities and rough terrain discount are already applied
+		std::vector<int> terrainMovementCost;
+
 		BonusCache(const TConstBonusListPtr & bonusList);
+		void updateTerrainMovementCost(TerrainId nativeTerrain);
 	};
 	std::unique_ptr<BonusCache> bonusCache;
 
@@ -48,6 +53,12 @@ struct DLL_LINKAGE TurnInfo
 	int valOfBonuses(const BonusType type, const BonusSubtypeID subtype) const;
 	void updateHeroBonuses(BonusType type, const CSelector& sel) const;
 	int getMaxMovePoints(const EPathfindingLayer & layer) const;
+
+	/// Returns cost of leaving tile of specified terrain when not moving along the road
+	int getTerrainMovementCost(TerrainId terrain) const
+	{
+		return bonusCache->terrainMovementCost[terrain.getNum()];
+	}
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -24,6 +24,7 @@
 #include "../CHeroHandler.h"
 #include "../constants/StringConstants.h"
 #include "../filesystem/Filesystem.h"
+#include "../TraceProfiler.h"
 #include "CZonePlacer.h"
 #include "TileInfo.h"
 #include "Zone.h"
@@ -115,18 +116,26 @@ void CMapGenerator::initQuestArtsRemaining()
 
 std::unique_ptr<CMap> CMapGenerator::generate()
 {
+	VCMI_PROFILE_ZONE("CMapGenerator::generate");
+
 	Load::Progress::reset();
 	Load::Progress::setupStepsTill(5, 30);
 	try
 	{
-		addHeaderInfo();
-		map->initTiles(*this, *rand);
+		{
+			VCMI_PROFILE_ZONE("CMapGenerator::initTiles");
+			addHeaderInfo();
+			map->initTiles(*this, *rand);
+		}
 		Load::Progress::step();
 		initQuestArtsRemaining();
 		genZones();
 		Load::Progress::step();
 		map->getMap(this).calculateGuardingGreaturePositions(); //clear map so that all tiles are unguarded
-		map->addModificators();
+		{
+			VCMI_PROFILE_ZONE("CMapGenerator::addModificators");
+			map->addModificators();
+		}
 		Load::Progress::step(3);
 		fillZones();
 		//updated guarded tiles will be calculated in CGameState::initMapObjects()
@@ -310,6 +319,8 @@ void CMapGenerator::addPlayerInfo()
 
 void CMapGenerator::genZones()
 {
+	VCMI_PROFILE_ZONE("CMapGenerator::genZones");
+
 	placer->placeZones(rand.get());
 	placer->assignZones(rand.get());
 
@@ -330,6 +341,8 @@ void CMapGenerator::addWaterTreasuresInfo()
 
 void CMapGenerator::fillZones()
 {
+	VCMI_PROFILE_ZONE("CMapGenerator::fillZones");
+
 	addWaterTreasuresInfo();
 
 	logGlobal->info("Started filling zones");
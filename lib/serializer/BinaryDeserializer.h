@@ -181,8 +181,37 @@ public:
 	void load(T &data)
 	{
 		uint32_t size = std::size(data);
-		for(uint32_t i = 0; i < size; i++)
-			load(data[i]);
+		loadElements(std::data(data), size);
+	}
+
+	/// Loads elements of contiguous container. Elements that are stored as copy of their memory are read in a single call
+	template<typename T>
+	void loadElements(T * data, uint32_t length)
+	{
+		if constexpr (is_serialized_as_memory_copy_v<T>)
+		{
+			if(length == 0)
+				return;
+
+			reader->read(reinterpret_cast<std::byte*>(data), length * sizeof(T));
+
+			if constexpr (sizeof(T) > 1)
+			{
+				if(reverseEndianness)
+				{
+					for(uint32_t i = 0; i < length; i++)
+					{
+						auto bytePtr = reinterpret_cast<std::byte*>(data + i);
+						std::reverse(bytePtr, bytePtr + sizeof(T));
+					}
+				}
+			}
+		}
+		else
+		{
+			for(uint32_t i = 0; i < length; i++)
+				load(data[i]);
+		}
 	}
 
 	void load(Version &data)
@@ -211,8 +240,7 @@ public:
 	{
 		uint32_t length = readAndCheckLength();
 		data.resize(length);
-		for(uint32_t i=0;i<length;i++)
-			load( data[i]);
+		loadElements(data.data(), length);
 	}
 
 	template <typename T, typename std::enable_if_t < !std::is_same_v<T, bool >, int  > = 0>
@@ -381,8 +409,7 @@ public:
 	template <typename T, size_t N>
 	void load(std::array<T, N> &data)
 	{
-		for(uint32_t i = 0; i < N; i++)
-			load( data[i] );
+		loadElements(data.data(), N);
 	}
 	template <typename T>
 	void load(std::set<T> &data)
@@ -528,8 +555,7 @@ public:
 		load(z);
 		data.resize(boost::extents[x][y][z]);
 		assert(length == data.num_elements()); //x*y*z should be equal to number of elements
-		for(uint32_t i = 0; i < length; i++)
-			load(data.data()[i]);
+		loadElements(data.data(), length);
 	}
 	template <std::size_t T>
 	void load(std::bitset<T> &data)
@@ -171,8 +171,22 @@ public:
 	void save(const T &data)
 	{
 		uint32_t size = std::size(data);
-		for(uint32_t i=0; i < size; i++)
-			*this & data[i];
+		saveElements(std::data(data), size);
+	}
+
+	/// Saves elements of contiguous container. Elements that are stored as copy of their memory are written in a single call
+	template<typename T>
+	void saveElements(const T * data, uint32_t length)
+	{
+		if constexpr (is_serialized_as_memory_copy_v<T>)
+		{
+			this->write(static_cast<const void *>(data), length * sizeof(T));
+		}
+		else
+		{
+			for(uint32_t i = 0; i < length; i++)
+				*this & data[i];
+		}
 	}
 
 	template < typename T, typename std::enable_if_t < std::is_pointer_v<T>, int  > = 0 >
@@ -285,8 +299,7 @@ public:
 	{
 		uint32_t length = data.size();
 		*this & length;
-		for(uint32_t i=0;i<length;i++)
-			save(data[i]);
+		saveElements(data.data(), length);
 	}
 	template <typename T, typename std::enable_if_t < !std::is_same_v<T, bool >, int  > = 0>
 	void save(const std::deque<T> & data)
@@ -299,8 +312,7 @@ public:
 	template <typename T, size_t N>
 	void save(const std::array<T, N> &data)
 	{
-		for(uint32_t i=0; i < N; i++)
-			save(data[i]);
+		saveElements(data.data(), N);
 	}
 	template <typename T>
 	void save(const std::set<T> &data)
@@ -434,8 +446,7 @@ public:
 		uint32_t y = shape[1];
 		uint32_t z = shape[2];
 		*this & x & y & z;
-		for(uint32_t i = 0; i < length; i++)
-			save(data.data()[i]);
+		saveElements(data.data(), length);
 	}
 	template <std::size_t T>
 	void save(const std::bitset<T> &data)
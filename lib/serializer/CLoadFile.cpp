@@ -10,8 +10,17 @@
 #include "StdInc.h"
 #include "CLoadFile.h"
 
+#include <zlib.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Size of pages in which data is read from file
+static constexpr size_t filePageSize = 1024 * 1024;
+/// Upper limit on number of sections in table of contents. Savegames only use few sections, larger values indicate corrupted file
+static constexpr uint32_t maxSectionsCount = 256;
+/// Maximal compression ratio that can be achieved by zlib
+static constexpr uint64_t maxCompressionRatio = 1032;
+
 CLoadFile::CLoadFile(const boost::filesystem::path & fname, ESerializationVersion minimalVersion)
 	: serializer(this)
 {
@@ -23,10 +32,177 @@ CLoadFile::~CLoadFile() = default;
 
 int CLoadFile::read(std::byte * data, unsigned size)
 {
-	sfile->read(reinterpret_cast<char *>(data), size);
+	if(sectionsInfo.empty())
+	{
+		readFromFile(data, size);
+		return size;
+	}
+
+	unsigned bytesRead = 0;
+	while(bytesRead < size)
+	{
+		if(currentSection >= sectionsInfo.size())
+			THROW_FORMAT("Error: attempt to read past the end of file %s!", fName);
+
+		if(sections[currentSection].empty())
+			sections[currentSection] = decompressSection(readCompressedSection(currentSection), currentSection);
+
+		auto & section = sections[currentSection];
+		size_t bytesToCopy = std::min<size_t>(size - bytesRead, section.size() - sectionReadPosition);
+		std::copy_n(section.data() + sectionReadPosition, bytesToCopy, data + bytesRead);
+		bytesRead += bytesToCopy;
+		sectionReadPosition += bytesToCopy;
+
+		if(sectionReadPosition == section.size())
+		{
+			section = {};
+			currentSection += 1;
+			sectionReadPosition = 0;
+		}
+	}
 	return size;
 }
 
+void CLoadFile::readFromFile(std::byte * data, size_t size)
+{
+	size_t bytesRead = 0;
+	while(bytesRead < size)
+	{
+		if(fileBufferPosition == fileBuffer.size())
+		{
+			fileBuffer.resize(filePageSize);
+			sfile->read(reinterpret_cast<char *>(fileBuffer.data()), fileBuffer.size());
+			fileBuffer.resize(sfile->gcount());
+			fileBufferPosition = 0;
+
+			if(fileBuffer.empty())
+				THROW_FORMAT("Error: attempt to read past the end of file %s!", fName);
+		}
+
+		size_t bytesToCopy = std::min(size - bytesRead, fileBuffer.size() - fileBufferPosition);
+		std::copy_n(fileBuffer.data() + fileBufferPosition, bytesToCopy, data + bytesRead);
+		bytesRead += bytesToCopy;
+		fileBufferPosition += bytesToCopy;
+		filePosition += bytesToCopy;
+	}
+}
+
+uint32_t CLoadFile::readLittleEndian()
+{
+	std::array<std::byte, 4> bytes;
+	readFromFile(bytes.data(), bytes.size());
+
+	uint32_t value = 0;
+	for(size_t i = 0; i < bytes.size(); ++i)
+		value |= std::to_integer<uint32_t>(bytes[i]) << (i * 8);
+	return value;
+}
+
+void CLoadFile::readTableOfContents()
+{
+	uint32_t sectionsCount = readLittleEndian();
+	if(sectionsCount > maxSectionsCount)
+		THROW_FORMAT("Error: invalid number of sections (%d) in file %s!", sectionsCount % fName);
+
+	sectionsInfo.resize(sectionsCount);
+	for(auto & section : sectionsInfo)
+	{
+		section.compressedSize = readLittleEndian();
+		section.uncompressedSize = readLittleEndian();
+	}
+
+	uint64_t fileSize = boost::filesystem::file_size(fName);
+	uint64_t offset = filePosition;
+	for(size_t i = 0; i < sectionsInfo.size(); ++i)
+	{
+		auto & section = sectionsInfo[i];
+
+		// checked before any memory is allocated for section, so corrupted table of contents can not cause huge allocations
+		if(offset + section.compressedSize > fileSize)
+			THROW_FORMAT("Error: section %d of file %s is located past the end of file!", i % fName);
+
+		if(section.uncompressedSize > section.compressedSize * maxCompressionRatio)
+			THROW_FORMAT("Error: section %d of file %s has invalid size!", i % fName);
+
+		section.fileOffset = offset;
+		offset += section.compressedSize;
+	}
+
+	sections.resize(sectionsCount);
+	currentSection = 0;
+	sectionReadPosition = 0;
+
+	// sections are read directly from file using offsets from table of contents
+	fileBuffer = {};
+	fileBufferPosition = 0;
+}
+
+std::vector<std::byte> CLoadFile::readCompressedSection(size_t index)
+{
+	const auto & info = sectionsInfo.at(index);
+	std::vector<std::byte> result(info.compressedSize);
+
+	sfile->clear();
+	sfile->seekg(info.fileOffset);
+	sfile->read(reinterpret_cast<char *>(result.data()), result.size());
+	if(static_cast<size_t>(sfile->gcount()) != result.size())
+		THROW_FORMAT("Error: section %d of file %s is truncated!", index % fName);
+
+	return result;
+}
+
+std::vector<std::byte> CLoadFile::decompressSection(const std::vector<std::byte> & compressed, size_t index) const
+{
+	const auto & info = sectionsInfo.at(index);
+	if(compressed.size() != info.compressedSize)
+		THROW_FORMAT("Error: section %d of file %s has unexpected size!", index % fName);
+
+	std::vector<std::byte> result(info.uncompressedSize);
+
+	uLongf decompressedSize = result.size();
+	int status = uncompress(reinterpret_cast<Bytef *>(result.data()), &decompressedSize, reinterpret_cast<const Bytef *>(compressed.data()), compressed.size());
+	if(status != Z_OK || decompressedSize != result.size())
+		THROW_FORMAT("Error: failed to decompress section %d of file %s!", index % fName);
+
+	return result;
+}
+
+void CLoadFile::decompressAllSections()
+{
+	std::vector<std::vector<std::byte>> compressedSections(sectionsInfo.size());
+	for(size_t i = currentSection; i < sectionsInfo.size(); ++i)
+		if(sections[i].empty())
+			compressedSections[i] = readCompressedSection(i);
+
+	std::vector<std::exception_ptr> errors(sectionsInfo.size());
+	std::vector<boost::thread> threads;
+
+	for(size_t i = currentSection; i < sectionsInfo.size(); ++i)
+	{
+		if(compressedSections[i].empty())
+			continue;
+
+		threads.emplace_back([this, i, &compressedSections, &errors]()
+		{
+			try
+			{
+				sections[i] = decompressSection(compressedSections[i], i);
+			}
+			catch(...)
+			{
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+
+	for(auto & thread : threads)
+		thread.join();
+
+	for(const auto & error : errors)
+		if(error)
+			std::rethrow_exception(error);
+}
+
 void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializationVersion minimalVersion)
 {
 	serializer.loadingGamestate = true;
@@ -37,14 +213,15 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 	{
 		fName = fname.string();
 		sfile = std::make_unique<std::fstream>(fname.c_str(), std::ios::in | std::ios::binary);
-		sfile->exceptions(std::ifstream::failbit | std::ifstream::badbit); //we throw a lot anyway
-
 		if(!(*sfile))
 			THROW_FORMAT("Error: cannot open to read %s!", fName);
 
+		// reads are done in large pages, short read at the end of file is expected and checked explicitly
+		sfile->exceptions(std::ifstream::badbit);
+
 		//we can read
 		char buffer[4];
-		sfile->read(buffer, 4);
+		readFromFile(reinterpret_cast<std::byte *>(buffer), 4);
 		if(std::memcmp(buffer, "VCMI", 4) != 0)
 			THROW_FORMAT("Error: not a VCMI file(%s)!", fName);
 
@@ -68,6 +245,9 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 			else
 				THROW_FORMAT("Error: too new file format (%s)!", fName);
 		}
+
+		if(serializer.version >= ESerializationVersion::SECTIONED_SAVEGAME)
+			readTableOfContents();
 	}
 	catch(...)
 	{
@@ -80,13 +260,20 @@ void CLoadFile::reportState(vstd::CLoggerBase * out)
 {
 	out->debug("CLoadFile");
 	if(!!sfile && *sfile)
-		out->debug("\tOpened %s Position: %d", fName, sfile->tellg());
+		out->debug("\tOpened %s Position: %d Section: %d/%d", fName, filePosition, currentSection, sectionsInfo.size());
 }
 
 void CLoadFile::clear()
 {
 	sfile = nullptr;
 	fName.clear();
+	fileBuffer.clear();
+	fileBufferPosition = 0;
+	filePosition = 0;
+	sectionsInfo.clear();
+	sections.clear();
+	currentSection = 0;
+	sectionReadPosition = 0;
 	serializer.version = ESerializationVersion::NONE;
 }
 
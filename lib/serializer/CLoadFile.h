@@ -15,6 +15,32 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 class DLL_LINKAGE CLoadFile : public IBinaryReader
 {
+	struct SectionInfo
+	{
+		size_t fileOffset;
+		uint32_t compressedSize;
+		uint32_t uncompressedSize;
+	};
+
+	/// table of contents of sectioned savegame. Empty for files in older, uncompressed format
+	std::vector<SectionInfo> sectionsInfo;
+	/// decompressed data of sections. Sections are decompressed on first access and released once fully read
+	std::vector<std::vector<std::byte>> sections;
+	size_t currentSection = 0;
+	size_t sectionReadPosition = 0;
+
+	/// page of file data used for reading of file header and of files in older, unsectioned format
+	std::vector<std::byte> fileBuffer;
+	size_t fileBufferPosition = 0;
+	/// number of bytes consumed from file via page buffer
+	size_t filePosition = 0;
+
+	void readFromFile(std::byte * data, size_t size);
+	uint32_t readLittleEndian();
+	void readTableOfContents();
+	std::vector<std::byte> readCompressedSection(size_t index);
+	std::vector<std::byte> decompressSection(const std::vector<std::byte> & compressed, size_t index) const;
+
 public:
 	BinaryDeserializer serializer;
 
@@ -31,6 +57,9 @@ public:
 
 	void checkMagicBytes(const std::string & text);
 
+	/// Decompresses all remaining sections of the file in parallel. Should be used if entire file is going to be loaded
+	void decompressAllSections(); //throws!
+
 	template<class T>
 	CLoadFile & operator>>(T &t)
 	{
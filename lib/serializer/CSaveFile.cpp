@@ -10,12 +10,44 @@
 #include "StdInc.h"
 #include "CSaveFile.h"
 
+#include <zlib.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Initial size of serialization buffer. Typical savegame is several megabytes in size
+static constexpr size_t initialBufferSize = 16 * 1024 * 1024;
+
+static void writeLittleEndian(std::ostream & stream, uint32_t value)
+{
+	std::array<char, 4> bytes;
+	for(size_t i = 0; i < bytes.size(); ++i)
+		bytes[i] = static_cast<char>((value >> (i * 8)) & 0xff);
+	stream.write(bytes.data(), bytes.size());
+}
+
+static std::vector<std::byte> compressSection(const std::byte * data, size_t size)
+{
+	uLongf compressedSize = compressBound(size);
+	std::vector<std::byte> result(compressedSize);
+
+	int status = compress2(reinterpret_cast<Bytef *>(result.data()), &compressedSize, reinterpret_cast<const Bytef *>(data), size, Z_DEFAULT_COMPRESSION);
+	if(status != Z_OK)
+		throw std::runtime_error("Failed to compress savegame section! Error code: " + std::to_string(status));
+
+	result.resize(compressedSize);
+	return result;
+}
+
 CSaveFile::CSaveFile(const boost::filesystem::path &fname)
 	: serializer(this)
+	, fName(fname)
 {
-	openNextFile(fname);
+	buffer.reserve(initialBufferSize);
+
+	putMagicBytes("VCMI"); //write magic identifier
+	serializer & ESerializationVersion::CURRENT; //write format version
+
+	preambleSize = buffer.size();
 }
 
 //must be instantiated in .cpp file for access to complete types of all member fields
@@ -23,28 +55,62 @@ CSaveFile::~CSaveFile() = default;
 
 int CSaveFile::write(const std::byte * data, unsigned size)
 {
-	sfile->write(reinterpret_cast<const char *>(data), size);
+	buffer.insert(buffer.end(), data, data + size);
 	return size;
 }
 
-void CSaveFile::openNextFile(const boost::filesystem::path &fname)
+void CSaveFile::beginSection()
+{
+	// section without any data would be identical to previous one
+	if(!sectionStarts.empty() && sectionStarts.back() == buffer.size())
+		return;
+
+	sectionStarts.push_back(buffer.size());
+}
+
+size_t CSaveFile::writeToFile() const
 {
-	fName = fname;
+	std::vector<size_t> sectionBoundaries = sectionStarts;
+	if(sectionBoundaries.empty() || sectionBoundaries.front() != preambleSize)
+		sectionBoundaries.insert(sectionBoundaries.begin(), preambleSize);
+	sectionBoundaries.push_back(buffer.size());
+
+	std::vector<std::vector<std::byte>> compressedSections;
+	for(size_t i = 0; i + 1 < sectionBoundaries.size(); ++i)
+		compressedSections.push_back(compressSection(buffer.data() + sectionBoundaries[i], sectionBoundaries[i + 1] - sectionBoundaries[i]));
+
+	boost::filesystem::path tempName = fName;
+	tempName += ".tmp";
+
 	try
 	{
-		sfile = std::make_unique<std::fstream>(fname.c_str(), std::ios::out | std::ios::binary);
-		sfile->exceptions(std::ifstream::failbit | std::ifstream::badbit); //we throw a lot anyway
+		size_t fileSize = 0;
+		{
+			std::ofstream file(tempName.c_str(), std::ios::out | std::ios::binary);
+			file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+
+			file.write(reinterpret_cast<const char *>(buffer.data()), preambleSize);
 
-		if(!(*sfile))
-			THROW_FORMAT("Error: cannot open to write %s!", fname);
+			writeLittleEndian(file, compressedSections.size());
+			for(size_t i = 0; i < compressedSections.size(); ++i)
+			{
+				writeLittleEndian(file, compressedSections[i].size());
+				writeLittleEndian(file, sectionBoundaries[i + 1] - sectionBoundaries[i]);
+			}
 
-		sfile->write("VCMI",4); //write magic identifier
-		serializer & ESerializationVersion::CURRENT; //write format version
+			for(const auto & section : compressedSections)
+				file.write(reinterpret_cast<const char *>(section.data()), section.size());
+
+			fileSize = file.tellp();
+		}
+		boost::filesystem::rename(tempName, fName);
+		return fileSize;
 	}
 	catch(...)
 	{
-		logGlobal->error("Failed to save to %s", fname.string());
-		clear();
+		logGlobal->error("Failed to save to %s", fName.string());
+		boost::system::error_code ec;
+		boost::filesystem::remove(tempName, ec);
 		throw;
 	}
 }
@@ -52,16 +118,7 @@ void CSaveFile::openNextFile(const boost::filesystem::path &fname)
 void CSaveFile::reportState(vstd::CLoggerBase * out)
 {
 	out->debug("CSaveFile");
-	if(sfile.get() && *sfile)
-	{
-		out->debug("\tOpened %s \tPosition: %d", fName, sfile->tellp());
-	}
-}
-
-void CSaveFile::clear()
-{
-	fName.clear();
-	sfile = nullptr;
+	out->debug("\tTarget %s \tSerialized: %d bytes in %d sections", fName, buffer.size(), sectionStarts.size());
 }
 
 void CSaveFile::putMagicBytes(const std::string &text)
@@ -13,24 +13,38 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Serializes savegame into memory buffer. Serialized data can then be written to disk
+/// using writeToFile, which does not need access to game state and can run on any thread
+/// On disk, data is stored as a sequence of independently compressed sections preceded by table of contents,
+/// which allows reading of leading sections, such as map header, without decompressing entire save
 class DLL_LINKAGE CSaveFile : public IBinaryWriter
 {
+	/// size of uncompressed file preamble: magic identifier and format version
+	size_t preambleSize;
+	/// offsets in buffer at which each section starts
+	std::vector<size_t> sectionStarts;
+
 public:
 	BinarySerializer serializer;
 
 	boost::filesystem::path fName;
-	std::unique_ptr<std::fstream> sfile;
+	std::vector<std::byte> buffer;
 
-	CSaveFile(const boost::filesystem::path &fname); //throws!
+	CSaveFile(const boost::filesystem::path &fname);
 	~CSaveFile();
 	int write(const std::byte * data, unsigned size) override;
 
-	void openNextFile(const boost::filesystem::path &fname); //throws!
-	void clear();
 	void reportState(vstd::CLoggerBase * out) override;
 
 	void putMagicBytes(const std::string &text);
 
+	/// Starts new section of the file. All data written after this call will be compressed separately from preceding data
+	void beginSection();
+
+	/// Compresses serialized data, writes it into temporary file and replaces target file with it
+	/// Existing file is never left partially overwritten, even if writing fails midway. Returns size of written file
+	size_t writeToFile() const; //throws!
+
 	template<class T>
 	CSaveFile & operator<<(const T &t)
 	{
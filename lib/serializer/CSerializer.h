@@ -141,6 +141,12 @@ struct is_serializeable
 	static const bool value = sizeof(Yes) == sizeof(is_serializeable::test((typename std::remove_reference_t<typename std::remove_cv_t<T>>*)nullptr));
 };
 
+/// Types that are stored in binary form as an exact copy of their memory representation, which allows
+/// containers of such types to be serialized using single read or write instead of element by element
+/// Multi-byte integers and enums are not included since they are stored using variable-length encoding
+template<typename T>
+constexpr bool is_serialized_as_memory_copy_v = std::is_floating_point_v<T> || (std::is_integral_v<T> && sizeof(T) == 1 && !std::is_same_v<T, bool>);
+
 template <typename T> //metafunction returning CGObjectInstance if T is its derivate or T elsewise
 struct VectorizedTypeFor
 {
@@ -60,6 +60,7 @@ enum class ESerializationVersion : int32_t
 	PER_MAP_GAME_SETTINGS, // 861 - game settings are now stored per-map
 	CAMPAIGN_OUTRO_SUPPORT, // 862 - support for campaign outro video
 	REWARDABLE_BANKS, // 863 - team state contains list of scouted objects, coast visitable rewardable objects
+	SECTIONED_SAVEGAME, // 864 - savegame is split into independently compressed sections with table of contents
 
-	CURRENT = REWARDABLE_BANKS
+	CURRENT = SECTIONED_SAVEGAME
 };
@@ -9,6 +9,7 @@
  */
 #include "StdInc.h"
 
+#include "LobbyLoadTest.h"
 #include "LobbyServer.h"
 
 #include "../lib/logging/CBasicLogConfigurator.h"
@@ -16,10 +17,47 @@
 #include "../lib/filesystem/Filesystem.h"
 #include "../lib/VCMIDirs.h"
 
+#include <boost/program_options.hpp>
+
 static const int LISTENING_PORT = 3031;
 
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("threads", boost::program_options::value<int>(), "number of threads used for network processing. Defaults to number of CPU cores")
+	("load-test", boost::program_options::value<int>(), "instead of running lobby, simulate specified number of users connecting to an existing lobby")
+	("load-test-host", boost::program_options::value<std::string>(), "address of lobby used for load test. Defaults to 127.0.0.1")
+	("load-test-duration", boost::program_options::value<int>(), "duration of load test in seconds. Defaults to 60");
+
+	try
+	{
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), options);
+	}
+	catch(boost::program_options::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+	}
+
+	boost::program_options::notify(options);
+
+	if(options.count("help"))
+	{
+		std::cout << opts;
+		exit(0);
+	}
+}
+
 int main(int argc, const char * argv[])
 {
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+
+	size_t networkThreadsCount = std::max(1u, boost::thread::hardware_concurrency());
+	if(opts.count("threads"))
+		networkThreadsCount = std::max(1, opts["threads"].as<int>());
+
 	CResourceHandler::initialize();
 	CResourceHandler::load("config/filesystem.json"); // FIXME: we actually need only config directory for schemas, can be reduced
 
@@ -29,6 +67,16 @@ int main(int argc, const char * argv[])
 	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_Lobby_log.txt", console);
 	logConfig.configureDefault();
 
+	if(opts.count("load-test"))
+	{
+		std::string host = opts.count("load-test-host") ? opts["load-test-host"].as<std::string>() : "127.0.0.1";
+		int durationSeconds = opts.count("load-test-duration") ? opts["load-test-duration"].as<int>() : 60;
+
+		LobbyLoadTest loadTest(host, LISTENING_PORT, opts["load-test"].as<int>(), std::chrono::seconds(durationSeconds));
+		loadTest.run(networkThreadsCount);
+		return 0;
+	}
+
 	auto databasePath = VCMIDirs::get().userDataPath() / "vcmiLobby.db";
 	logGlobal->info("Opening database %s", databasePath.string());
 
@@ -44,7 +92,7 @@ int main(int argc, const char * argv[])
 		logGlobal->error("Failed to start server! Another server already uses the same port? Reason: '%s'", e.what());
 		return 1;
 	}
-	server.run();
+	server.run(networkThreadsCount);
 
 	return 0;
 }
@@ -137,8 +137,31 @@ void LobbyDatabase::clearOldData()
 	database->prepare(removeActiveGameRooms)->execute();
 }
 
+void LobbyDatabase::configureDatabase()
+{
+	// WAL mode allows readers to proceed during writes and requires fsync only on checkpoints
+	// Transactions are committed periodically by write-behind anyway, so 'normal' synchronization mode is sufficient
+	database->prepare(R"(
+		PRAGMA journal_mode = WAL
+	)")->execute();
+
+	database->prepare(R"(
+		PRAGMA synchronous = NORMAL
+	)")->execute();
+}
+
 void LobbyDatabase::prepareStatements()
 {
+	// TRANSACTIONS
+
+	beginTransactionStatement = database->prepare(R"(
+		BEGIN TRANSACTION
+	)");
+
+	commitTransactionStatement = database->prepare(R"(
+		COMMIT TRANSACTION
+	)");
+
 	// INSERT INTO
 
 	insertChatMessageStatement = database->prepare(R"(
@@ -337,19 +360,83 @@ void LobbyDatabase::prepareStatements()
 	)");
 }
 
-LobbyDatabase::~LobbyDatabase() = default;
+LobbyDatabase::~LobbyDatabase()
+{
+	try
+	{
+		flush();
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Failed to commit pending lobby database writes: %s", e.what());
+	}
+}
 
 LobbyDatabase::LobbyDatabase(const boost::filesystem::path & databasePath)
 {
 	database = SQLiteInstance::open(databasePath, true);
+	configureDatabase();
 	createTables();
 	upgradeDatabase();
 	clearOldData();
 	prepareStatements();
 }
 
+bool LobbyDatabase::isGameRoomFinished(LobbyRoomState roomStatus)
+{
+	return roomStatus == LobbyRoomState::CANCELLED || roomStatus == LobbyRoomState::CLOSED;
+}
+
+void LobbyDatabase::cacheDisplayName(const std::string & accountID, const std::string & displayName)
+{
+	if (displayNameCache.size() >= maxCacheSize)
+		displayNameCache.clear();
+	displayNameCache[accountID] = displayName;
+}
+
+void LobbyDatabase::cacheValidCookie(const std::string & accountID, const std::string & accessCookieUUID)
+{
+	if (validCookiesCache.size() >= maxCacheSize)
+		validCookiesCache.clear();
+	validCookiesCache.emplace(accountID, accessCookieUUID);
+}
+
+void LobbyDatabase::beginWrite()
+{
+	// limit size of a single transaction in case of sudden burst of activity
+	static constexpr uint32_t maxPendingWrites = 1000;
+
+	if (pendingWrites >= maxPendingWrites)
+		flush();
+
+	if (!transactionActive)
+	{
+		beginTransactionStatement->execute();
+		beginTransactionStatement->reset();
+		transactionActive = true;
+	}
+	pendingWrites += 1;
+}
+
+void LobbyDatabase::flush()
+{
+	if (!transactionActive)
+		return;
+
+	commitTransactionStatement->execute();
+	commitTransactionStatement->reset();
+	transactionActive = false;
+	pendingWrites = 0;
+}
+
+bool LobbyDatabase::hasPendingWrites() const
+{
+	return transactionActive;
+}
+
 void LobbyDatabase::insertChatMessage(const std::string & sender, const std::string & channelType, const std::string & channelName, const std::string & messageText)
 {
+	beginWrite();
 	insertChatMessageStatement->executeOnce(sender, messageText, channelType, channelName);
 }
 
@@ -411,78 +498,115 @@ std::vector<LobbyChatMessage> LobbyDatabase::getFullMessageHistory(const std::st
 
 void LobbyDatabase::setAccountOnline(const std::string & accountID, bool isOnline)
 {
+	beginWrite();
 	setAccountOnlineStatement->executeOnce(isOnline ? 1 : 0, accountID);
 }
 
 void LobbyDatabase::setGameRoomStatus(const std::string & roomID, LobbyRoomState roomStatus)
 {
+	beginWrite();
 	setGameRoomStatusStatement->executeOnce(vstd::to_underlying(roomStatus), roomID);
+
+	// finished rooms are never reopened, and are only queried rarely afterwards
+	if (isGameRoomFinished(roomStatus))
+		gameRoomStatusCache.erase(roomID);
+	else
+		gameRoomStatusCache[roomID] = roomStatus;
 }
 
 void LobbyDatabase::insertPlayerIntoGameRoom(const std::string & accountID, const std::string & roomID)
 {
+	beginWrite();
 	insertGameRoomPlayersStatement->executeOnce(roomID, accountID);
 }
 
 void LobbyDatabase::deletePlayerFromGameRoom(const std::string & accountID, const std::string & roomID)
 {
+	beginWrite();
 	deleteGameRoomPlayersStatement->executeOnce(roomID, accountID);
 }
 
 void LobbyDatabase::deleteGameRoomInvite(const std::string & targetAccountID, const std::string & roomID)
 {
+	beginWrite();
 	deleteGameRoomInvitesStatement->executeOnce(roomID, targetAccountID);
 }
 
 void LobbyDatabase::insertGameRoomInvite(const std::string & targetAccountID, const std::string & roomID)
 {
+	beginWrite();
 	insertGameRoomInvitesStatement->executeOnce(roomID, targetAccountID);
 }
 
 void LobbyDatabase::insertGameRoom(const std::string & roomID, const std::string & hostAccountID, const std::string & serverVersion, const std::string & modListJson)
 {
+	beginWrite();
 	insertGameRoomStatement->executeOnce(roomID, hostAccountID, serverVersion, modListJson);
+	gameRoomStatusCache[roomID] = LobbyRoomState::IDLE;
 }
 
 void LobbyDatabase::insertAccount(const std::string & accountID, const std::string & displayName)
 {
+	beginWrite();
 	insertAccountStatement->executeOnce(accountID, displayName);
+	cacheDisplayName(accountID, displayName);
 }
 
 void LobbyDatabase::insertAccessCookie(const std::string & accountID, const std::string & accessCookieUUID)
 {
+	beginWrite();
 	insertAccessCookieStatement->executeOnce(accountID, accessCookieUUID);
+	cacheValidCookie(accountID, accessCookieUUID);
 }
 
 void LobbyDatabase::updateAccountLoginTime(const std::string & accountID)
 {
+	beginWrite();
 	updateAccountLoginTimeStatement->executeOnce(accountID);
 }
 
 void LobbyDatabase::updateRoomPlayerLimit(const std::string & gameRoomID, int playerLimit)
 {
+	beginWrite();
 	updateRoomPlayerLimitStatement->executeOnce(playerLimit, gameRoomID);
 }
 
 void LobbyDatabase::updateRoomDescription(const std::string & gameRoomID, const std::string & description)
 {
+	beginWrite();
 	updateRoomDescriptionStatement->executeOnce(description, gameRoomID);
 }
 
 std::string LobbyDatabase::getAccountDisplayName(const std::string & accountID)
 {
+	auto cached = displayNameCache.find(accountID);
+	if (cached != displayNameCache.end())
+		return cached->second;
+
 	std::string result;
+	bool accountFound = false;
 
 	getAccountDisplayNameStatement->setBinds(accountID);
 	if(getAccountDisplayNameStatement->execute())
+	{
 		getAccountDisplayNameStatement->getColumns(result);
+		accountFound = true;
+	}
 	getAccountDisplayNameStatement->reset();
 
+	// display name can not be changed, so it is safe to cache it indefinitely
+	if (accountFound)
+		cacheDisplayName(accountID, result);
+
 	return result;
 }
 
 LobbyCookieStatus LobbyDatabase::getAccountCookieStatus(const std::string & accountID, const std::string & accessCookieUUID)
 {
+	// cookies are never removed, so only valid cookies are cached
+	if (validCookiesCache.count({accountID, accessCookieUUID}))
+		return LobbyCookieStatus::VALID;
+
 	bool result = false;
 
 	isAccountCookieValidStatement->setBinds(accountID, accessCookieUUID);
@@ -490,7 +614,11 @@ LobbyCookieStatus LobbyDatabase::getAccountCookieStatus(const std::string & acco
 		isAccountCookieValidStatement->getColumns(result);
 	isAccountCookieValidStatement->reset();
 
-	return result ? LobbyCookieStatus::VALID : LobbyCookieStatus::INVALID;
+	if (!result)
+		return LobbyCookieStatus::INVALID;
+
+	cacheValidCookie(accountID, accessCookieUUID);
+	return LobbyCookieStatus::VALID;
 }
 
 LobbyInviteStatus LobbyDatabase::getAccountInviteStatus(const std::string & accountID, const std::string & roomID)
@@ -510,11 +638,19 @@ LobbyInviteStatus LobbyDatabase::getAccountInviteStatus(const std::string & acco
 
 LobbyRoomState LobbyDatabase::getGameRoomStatus(const std::string & roomID)
 {
+	auto cached = gameRoomStatusCache.find(roomID);
+	if (cached != gameRoomStatusCache.end())
+		return cached->second;
+
 	LobbyRoomState result;
 
 	getGameRoomStatusStatement->setBinds(roomID);
 	if(getGameRoomStatusStatement->execute())
+	{
 		getGameRoomStatusStatement->getColumns(result);
+		if (!isGameRoomFinished(result))
+			gameRoomStatusCache[roomID] = result;
+	}
 	else
 		result = LobbyRoomState::CLOSED;
 
@@ -556,6 +692,9 @@ bool LobbyDatabase::isAccountNameExists(const std::string & displayName)
 
 bool LobbyDatabase::isAccountIDExists(const std::string & accountID)
 {
+	if (displayNameCache.count(accountID))
+		return true;
+
 	bool result = false;
 
 	isAccountIDExistsStatement->setBinds(accountID);
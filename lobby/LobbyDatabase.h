@@ -59,6 +59,28 @@ class LobbyDatabase
 	SQLiteStatementPtr isAccountIDExistsStatement;
 	SQLiteStatementPtr isAccountNameExistsStatement;
 
+	SQLiteStatementPtr beginTransactionStatement;
+	SQLiteStatementPtr commitTransactionStatement;
+
+	/// Write-behind: all modifications are executed inside transaction that is only committed on flush()
+	/// Reads use the same connection, so they always see not yet committed modifications
+	bool transactionActive = false;
+	uint32_t pendingWrites = 0;
+
+	/// Read-through caches for queries that are executed on most of incoming messages
+	/// Only contain data that can not become stale without going through this class
+	/// Rooms are removed once finished, other caches are reset once they reach size limit
+	static constexpr size_t maxCacheSize = 65536;
+	std::map<std::string, std::string> displayNameCache;
+	std::set<std::pair<std::string, std::string>> validCookiesCache;
+	std::map<std::string, LobbyRoomState> gameRoomStatusCache;
+
+	static bool isGameRoomFinished(LobbyRoomState roomStatus);
+	void cacheDisplayName(const std::string & accountID, const std::string & displayName);
+	void cacheValidCookie(const std::string & accountID, const std::string & accessCookieUUID);
+
+	void beginWrite();
+	void configureDatabase();
 	void prepareStatements();
 	void createTables();
 	void upgradeDatabase();
@@ -68,6 +90,10 @@ public:
 	explicit LobbyDatabase(const boost::filesystem::path & databasePath);
 	~LobbyDatabase();
 
+	/// Commits all modifications made since last flush to disk
+	void flush();
+	bool hasPendingWrites() const;
+
 	void setAccountOnline(const std::string & accountID, bool isOnline);
 	void setGameRoomStatus(const std::string & roomID, LobbyRoomState roomStatus);
 
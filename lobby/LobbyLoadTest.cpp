@@ -0,0 +1,156 @@
+/*
+ * LobbyLoadTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "LobbyLoadTest.h"
+
+#include "../lib/json/JsonNode.h"
+
+static const std::string loadTestChannel = "english";
+
+LobbyLoadTest::LobbyLoadTest(const std::string & host, uint16_t port, int usersCount, std::chrono::seconds duration)
+	: networkHandler(INetworkHandler::createHandler())
+	, host(host)
+	, port(port)
+	, usersCount(usersCount)
+	, duration(duration)
+{
+}
+
+LobbyLoadTest::~LobbyLoadTest() = default;
+
+void LobbyLoadTest::run(size_t networkThreadsCount)
+{
+	logGlobal->info("Starting load test: %d users, %d seconds, lobby at %s:%d", usersCount, duration.count(), host, port);
+
+	startTime = std::chrono::steady_clock::now();
+	for(int i = 0; i < usersCount; ++i)
+		networkHandler->connectToRemote(*this, host, port);
+
+	networkHandler->createTimer(*this, std::chrono::seconds(1));
+	networkHandler->run(networkThreadsCount);
+
+	logGlobal->info("Load test finished: %d connections established, %d failed, %d accounts logged in", connectionsEstablished.load(), connectionsFailed.load(), accountsLoggedIn.load());
+	logGlobal->info("Load test finished: %d messages sent, %d messages received, %.1f messages received per second", messagesSent.load(), messagesReceived.load(), static_cast<double>(messagesReceived.load()) / duration.count());
+}
+
+void LobbyLoadTest::sendMessage(const NetworkConnectionPtr & connection, const JsonNode & json)
+{
+	messagesSent += 1;
+	connection->sendPacket(json.toBytes());
+}
+
+void LobbyLoadTest::onConnectionFailed(const std::string & errorMessage)
+{
+	connectionsFailed += 1;
+	logGlobal->warn("Load test: connection failed: %s", errorMessage);
+}
+
+void LobbyLoadTest::onConnectionEstablished(const NetworkConnectionPtr & connection)
+{
+	int connectionIndex = connectionsEstablished++;
+	connection->setAsyncWritesEnabled(true);
+
+	{
+		std::lock_guard lock(usersMutex);
+		users[connection] = {};
+	}
+
+	auto timeSinceStart = std::chrono::steady_clock::now() - startTime;
+	auto randomSuffix = std::chrono::duration_cast<std::chrono::microseconds>(timeSinceStart).count();
+
+	JsonNode toSend;
+	toSend["type"].String() = "clientRegister";
+	toSend["displayName"].String() = "loadtest" + std::to_string(connectionIndex) + "_" + std::to_string(randomSuffix % 100000);
+	toSend["language"].String() = loadTestChannel;
+	toSend["version"].String() = VCMI_VERSION_STRING;
+	sendMessage(connection, toSend);
+}
+
+void LobbyLoadTest::onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage)
+{
+	logGlobal->warn("Load test: connection lost: %s", errorMessage);
+
+	std::lock_guard lock(usersMutex);
+	users.erase(connection);
+}
+
+void LobbyLoadTest::onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message)
+{
+	messagesReceived += 1;
+
+	JsonNode json(message.data(), message.size(), "<lobby network packet>");
+	const std::string & messageType = json["type"].String();
+
+	if(messageType == "accountCreated")
+	{
+		{
+			std::lock_guard lock(usersMutex);
+			users[connection].accountID = json["accountID"].String();
+		}
+
+		JsonNode toSend;
+		toSend["type"].String() = "clientLogin";
+		toSend["accountID"] = json["accountID"];
+		toSend["accountCookie"] = json["accountCookie"];
+		toSend["language"].String() = loadTestChannel;
+		toSend["version"].String() = VCMI_VERSION_STRING;
+		sendMessage(connection, toSend);
+	}
+
+	if(messageType == "clientLoginSuccess")
+	{
+		{
+			std::lock_guard lock(usersMutex);
+			users[connection].loggedIn = true;
+		}
+		accountsLoggedIn += 1;
+	}
+
+	if(messageType == "operationFailed")
+		logGlobal->warn("Load test: operation failed: %s", json["reason"].String());
+}
+
+void LobbyLoadTest::onTimer()
+{
+	elapsedSeconds += 1;
+
+	int64_t totalMessages = messagesReceived.load();
+	int totalConnections = connectionsEstablished.load();
+	logGlobal->info("Load test: %d s, %d connections (%d per second), %d logged in, %d messages received per second", elapsedSeconds, totalConnections, totalConnections - lastReportedConnections, accountsLoggedIn.load(), totalMessages - lastReportedMessages);
+	lastReportedMessages = totalMessages;
+	lastReportedConnections = totalConnections;
+
+	if(std::chrono::seconds(elapsedSeconds) >= duration)
+	{
+		networkHandler->stop();
+		return;
+	}
+
+	// every logged in user sends one chat message per second, which lobby then broadcasts to all users
+	std::vector<NetworkConnectionPtr> activeConnections;
+	{
+		std::lock_guard lock(usersMutex);
+		for(const auto & user : users)
+			if(user.second.loggedIn)
+				activeConnections.push_back(user.first);
+	}
+
+	for(const auto & connection : activeConnections)
+	{
+		JsonNode toSend;
+		toSend["type"].String() = "sendChatMessage";
+		toSend["channelType"].String() = "global";
+		toSend["channelName"].String() = loadTestChannel;
+		toSend["messageText"].String() = "load test message " + std::to_string(elapsedSeconds);
+		sendMessage(connection, toSend);
+	}
+
+	networkHandler->createTimer(*this, std::chrono::seconds(1));
+}
@@ -0,0 +1,63 @@
+/*
+ * LobbyLoadTest.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/network/NetworkInterface.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+/// Simulates specified number of lobby users in order to measure lobby server throughput
+/// Each user registers new account, logs in and then periodically sends messages to global chat
+class LobbyLoadTest final : public INetworkClientListener, public INetworkTimerListener
+{
+	struct SimulatedUser
+	{
+		std::string accountID;
+		bool loggedIn = false;
+	};
+
+	std::unique_ptr<INetworkHandler> networkHandler;
+
+	std::string host;
+	uint16_t port;
+	int usersCount;
+	std::chrono::seconds duration;
+
+	std::mutex usersMutex;
+	std::map<NetworkConnectionPtr, SimulatedUser> users;
+
+	std::atomic<int> connectionsEstablished = 0;
+	std::atomic<int> connectionsFailed = 0;
+	std::atomic<int> accountsLoggedIn = 0;
+	std::atomic<int64_t> messagesSent = 0;
+	std::atomic<int64_t> messagesReceived = 0;
+
+	std::chrono::steady_clock::time_point startTime;
+	int64_t lastReportedMessages = 0;
+	int lastReportedConnections = 0;
+	int elapsedSeconds = 0;
+
+	void sendMessage(const NetworkConnectionPtr & connection, const JsonNode & json);
+
+	void onConnectionFailed(const std::string & errorMessage) override;
+	void onConnectionEstablished(const NetworkConnectionPtr & connection) override;
+	void onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage) override;
+	void onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message) override;
+	void onTimer() override;
+
+public:
+	LobbyLoadTest(const std::string & host, uint16_t port, int usersCount, std::chrono::seconds duration);
+	~LobbyLoadTest();
+
+	/// Runs load test and logs statistics every second. Returns once test duration has passed
+	void run(size_t networkThreadsCount);
+};
@@ -18,6 +18,8 @@
 #include "../lib/texts/Languages.h"
 #include "../lib/texts/TextOperations.h"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
@@ -84,7 +86,7 @@ void LobbyServer::sendMessage(const NetworkConnectionPtr & target, const JsonNod
 	logGlobal->info("Sending message of type %s", json["type"].String());
 
 	assert(JsonUtils::validate(json, "vcmi:lobbyProtocol/" + json["type"].String(), json["type"].String() + " pack"));
-	target->sendPacket(json.toBytes());
+	target->sendPacket(std::make_shared<const std::vector<std::byte>>(json.toBytes()));
 }
 
 void LobbyServer::sendAccountCreated(const NetworkConnectionPtr & target, const std::string & accountID, const std::string & accountCookie)
@@ -163,25 +165,37 @@ void LobbyServer::sendChatHistory(const NetworkConnectionPtr & target, const std
 	sendMessage(target, reply);
 }
 
-void LobbyServer::broadcastActiveAccounts()
+void LobbyServer::broadcastMessage(const JsonNode & json)
 {
-	auto activeAccountsStats = database->getActiveAccounts();
+	logGlobal->info("Broadcasting message of type %s to %d accounts", json["type"].String(), activeAccounts.size());
 
+	assert(JsonUtils::validate(json, "vcmi:lobbyProtocol/" + json["type"].String(), json["type"].String() + " pack"));
+	// serialized once and shared between all connections, without per-connection copies
+	auto data = std::make_shared<const std::vector<std::byte>>(json.toBytes());
+
+	for(const auto & connection : activeAccounts)
+		connection.first->sendPacket(data);
+}
+
+static JsonNode loadActiveAccountToJson(const LobbyAccount & account)
+{
+	JsonNode jsonEntry;
+	jsonEntry["accountID"].String() = account.accountID;
+	jsonEntry["displayName"].String() = account.displayName;
+	jsonEntry["status"].String() = "In Lobby"; // TODO: in room status, in match status, offline status(?)
+	return jsonEntry;
+}
+
+JsonNode LobbyServer::prepareActiveAccounts()
+{
 	JsonNode reply;
 	reply["type"].String() = "activeAccounts";
 	reply["accounts"].Vector(); // force creation of empty vector
 
-	for(const auto & account : activeAccountsStats)
-	{
-		JsonNode jsonEntry;
-		jsonEntry["accountID"].String() = account.accountID;
-		jsonEntry["displayName"].String() = account.displayName;
-		jsonEntry["status"].String() = "In Lobby"; // TODO: in room status, in match status, offline status(?)
-		reply["accounts"].Vector().push_back(jsonEntry);
-	}
+	for(const auto & account : onlineAccounts)
+		reply["accounts"].Vector().push_back(loadActiveAccountToJson(account.second));
 
-	for(const auto & connection : activeAccounts)
-		sendMessage(connection.first, reply);
+	return reply;
 }
 
 static JsonNode loadLobbyAccountToJson(const LobbyAccount & account)
@@ -252,12 +266,90 @@ JsonNode LobbyServer::prepareActiveGameRooms()
 	return reply;
 }
 
-void LobbyServer::broadcastActiveGameRooms()
+void LobbyServer::markAccountChanged(const std::string & accountID)
 {
-	auto reply = prepareActiveGameRooms();
+	changedAccounts.insert(accountID);
+	scheduleDeferredUpdate();
+}
 
-	for(const auto & connection : activeAccounts)
-		sendMessage(connection.first, reply);
+void LobbyServer::markGameRoomChanged(const std::string & gameRoomID)
+{
+	changedGameRooms.insert(gameRoomID);
+	scheduleDeferredUpdate();
+}
+
+void LobbyServer::scheduleDeferredUpdate()
+{
+	// time during which presence changes and database writes are accumulated into a single update
+	static constexpr std::chrono::milliseconds deferredUpdateDelay(250);
+
+	if(deferredUpdateScheduled)
+		return;
+
+	deferredUpdateScheduled = true;
+	networkHandler->createTimer(*this, deferredUpdateDelay);
+}
+
+void LobbyServer::onTimer()
+{
+	boost::asio::post(*databaseExecutor, [this]()
+	{
+		deferredUpdateScheduled = false;
+		database->flush();
+		broadcastPresenceUpdate();
+	});
+}
+
+void LobbyServer::scheduleDatabaseFlush()
+{
+	if(database->hasPendingWrites())
+		scheduleDeferredUpdate();
+}
+
+void LobbyServer::broadcastPresenceUpdate()
+{
+
+	if(!changedAccounts.empty())
+	{
+		JsonNode update;
+		update["type"].String() = "activeAccountsUpdate";
+		update["joined"].Vector(); // force creation of empty vector
+		update["left"].Vector();
+
+		for(const auto & accountID : changedAccounts)
+		{
+			auto account = onlineAccounts.find(accountID);
+
+			if(account != onlineAccounts.end())
+				update["joined"].Vector().push_back(loadActiveAccountToJson(account->second));
+			else
+				update["left"].Vector().push_back(JsonNode(accountID));
+		}
+
+		changedAccounts.clear();
+		broadcastMessage(update);
+	}
+
+	if(!changedGameRooms.empty())
+	{
+		JsonNode update;
+		update["type"].String() = "activeGameRoomsUpdate";
+		update["changed"].Vector(); // force creation of empty vector
+		update["removed"].Vector();
+
+		for(const auto & gameRoom : database->getActiveGameRooms())
+		{
+			if(changedGameRooms.erase(gameRoom.roomID))
+				update["changed"].Vector().push_back(loadLobbyGameRoomToJson(gameRoom));
+		}
+
+		// rooms that are no longer present in list of active rooms
+		for(const auto & gameRoomID : changedGameRooms)
+			update["removed"].Vector().push_back(JsonNode(gameRoomID));
+
+		changedGameRooms.clear();
+		broadcastMessage(update);
+	}
 }
 
 void LobbyServer::sendAccountJoinsRoom(const NetworkConnectionPtr & target, const std::string & accountID)
@@ -297,12 +389,29 @@ void LobbyServer::onNewConnection(const NetworkConnectionPtr & connection)
 }
 
 void LobbyServer::onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage)
+{
+	boost::asio::post(*databaseExecutor, [this, connection, errorMessage]()
+	{
+		processDisconnected(connection, errorMessage);
+		scheduleDatabaseFlush();
+	});
+}
+
+void LobbyServer::processDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage)
 {
 	if(activeAccounts.count(connection))
 	{
-		logGlobal->info("Account %s disconnecting. Accounts online: %d", activeAccounts.at(connection), activeAccounts.size() - 1);
-		database->setAccountOnline(activeAccounts.at(connection), false);
+		std::string accountID = activeAccounts.at(connection);
+		logGlobal->info("Account %s disconnecting. Accounts online: %d", accountID, activeAccounts.size() - 1);
+		database->setAccountOnline(accountID, false);
 		activeAccounts.erase(connection);
+
+		// same account might still be logged in from another connection
+		if(!findAccount(accountID))
+		{
+			onlineAccounts.erase(accountID);
+			markAccountChanged(accountID);
+		}
 	}
 
 	if(activeGameRooms.count(connection))
@@ -321,6 +430,7 @@ void LobbyServer::onDisconnected(const NetworkConnectionPtr & connection, const
 			database->setGameRoomStatus(gameRoomID, LobbyRoomState::CANCELLED);
 
 		activeGameRooms.erase(connection);
+		markGameRoomChanged(gameRoomID);
 	}
 
 	if(activeProxies.count(connection))
@@ -333,9 +443,6 @@ void LobbyServer::onDisconnected(const NetworkConnectionPtr & connection, const
 		activeProxies.erase(connection);
 		activeProxies.erase(otherConnection);
 	}
-
-	broadcastActiveAccounts();
-	broadcastActiveGameRooms();
 }
 
 JsonNode LobbyServer::parseAndValidateMessage(const std::vector<std::byte> & message) const
@@ -377,7 +484,39 @@ JsonNode LobbyServer::parseAndValidateMessage(const std::vector<std::byte> & mes
 	return json;
 }
 
+bool LobbyServer::isProxyLoginMessage(const std::vector<std::byte> & message) const
+{
+	try
+	{
+		const JsonNode json(message.data(), message.size(), "<lobby message>");
+		return json.isStruct() && json["type"].isString() && json["type"].String() == "clientProxyLogin";
+	}
+	catch (const JsonFormatException &)
+	{
+		return false;
+	}
+}
+
 void LobbyServer::onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message)
+{
+	// successful proxy login switches connection into relay mode. Data that arrives before that must not be read as packets,
+	// so reading is paused until login has been processed on database thread
+	bool proxyLogin = isProxyLoginMessage(message);
+	if (proxyLogin)
+		connection->pauseReceiving();
+
+	// network thread reuses message buffer once this call returns, so message must be copied
+	boost::asio::post(*databaseExecutor, [this, connection, message, proxyLogin]()
+	{
+		processPacket(connection, message);
+		scheduleDatabaseFlush();
+
+		if (proxyLogin)
+			connection->resumeReceiving();
+	});
+}
+
+void LobbyServer::processPacket(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message)
 {
 	// proxy connection - no processing, only redirect
 	if(activeProxies.count(connection))
@@ -603,6 +742,7 @@ void LobbyServer::receiveClientLogin(const NetworkConnectionPtr & connection, co
 	std::string displayName = database->getAccountDisplayName(accountID);
 
 	activeAccounts[connection] = accountID;
+	onlineAccounts[accountID] = LobbyAccount{accountID, displayName};
 
 	logGlobal->info("%s: Logged in as %s", accountID, displayName);
 	sendClientLoginSuccess(connection, accountCookie, displayName);
@@ -610,9 +750,10 @@ void LobbyServer::receiveClientLogin(const NetworkConnectionPtr & connection, co
 	if (language != "english")
 		sendRecentChatHistory(connection, "global", language);
 
-	// send active game rooms list to new account
-	// and update account list to everybody else including new account
-	broadcastActiveAccounts();
+	// send full lists of accounts and game rooms to new account
+	// and notify everybody else about new account with next presence update
+	markAccountChanged(accountID);
+	sendMessage(connection, prepareActiveAccounts());
 	sendMessage(connection, prepareActiveGameRooms());
 	sendMatchesHistory(connection);
 }
@@ -636,7 +777,7 @@ void LobbyServer::receiveServerLogin(const NetworkConnectionPtr & connection, co
 		database->insertGameRoom(gameRoomID, accountID, version, modListString);
 		activeGameRooms[connection] = gameRoomID;
 		sendServerLoginSuccess(connection, accountCookie);
-		broadcastActiveGameRooms();
+		markGameRoomChanged(gameRoomID);
 	}
 }
 
@@ -665,6 +806,10 @@ void LobbyServer::receiveClientProxyLogin(const NetworkConnectionPtr & connectio
 			{
 				activeProxies[gameRoomConnection] = connection;
 				activeProxies[connection] = gameRoomConnection;
+
+				// from now on data is forwarded directly between sockets, bypassing packet processing
+				gameRoomConnection->startRelay(connection);
+				connection->startRelay(gameRoomConnection);
 			}
 			return;
 		}
@@ -730,7 +875,7 @@ void LobbyServer::receiveActivateGameRoom(const NetworkConnectionPtr & connectio
 
 	database->updateRoomPlayerLimit(gameRoomID, playerLimit);
 	database->insertPlayerIntoGameRoom(accountID, gameRoomID);
-	broadcastActiveGameRooms();
+	markGameRoomChanged(gameRoomID);
 	sendJoinRoomSuccess(connection, gameRoomID, false);
 }
 
@@ -765,7 +910,7 @@ void LobbyServer::receiveJoinGameRoom(const NetworkConnectionPtr & connection, c
 	sendAccountJoinsRoom(targetRoom, accountID);
 	//No reply to client - will be sent once match server establishes proxy connection with lobby
 
-	broadcastActiveGameRooms();
+	markGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveChangeRoomDescription(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -774,7 +919,7 @@ void LobbyServer::receiveChangeRoomDescription(const NetworkConnectionPtr & conn
 	std::string description = json["description"].String();
 
 	database->updateRoomDescription(gameRoomID, description);
-	broadcastActiveGameRooms();
+	markGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveGameStarted(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -782,7 +927,7 @@ void LobbyServer::receiveGameStarted(const NetworkConnectionPtr & connection, co
 	std::string gameRoomID = activeGameRooms[connection];
 
 	database->setGameRoomStatus(gameRoomID, LobbyRoomState::BUSY);
-	broadcastActiveGameRooms();
+	markGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveLeaveGameRoom(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -795,7 +940,7 @@ void LobbyServer::receiveLeaveGameRoom(const NetworkConnectionPtr & connection,
 
 	database->deletePlayerFromGameRoom(accountID, gameRoomID);
 
-	broadcastActiveGameRooms();
+	markGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveSendInvite(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -820,15 +965,20 @@ void LobbyServer::receiveSendInvite(const NetworkConnectionPtr & connection, con
 
 	database->insertGameRoomInvite(accountID, gameRoomID);
 	sendInviteReceived(targetAccountConnection, senderName, gameRoomID);
-	broadcastActiveGameRooms();
+	markGameRoomChanged(gameRoomID);
 }
 
-LobbyServer::~LobbyServer() = default;
+LobbyServer::~LobbyServer()
+{
+	// finish all pending database work before network and database are destroyed
+	databaseExecutor->join();
+}
 
 LobbyServer::LobbyServer(const boost::filesystem::path & databasePath)
 	: database(std::make_unique<LobbyDatabase>(databasePath))
 	, networkHandler(INetworkHandler::createHandler())
 	, networkServer(networkHandler->createServerTCP(*this))
+	, databaseExecutor(std::make_unique<boost::asio::thread_pool>(1))
 {
 }
 
@@ -837,7 +987,8 @@ void LobbyServer::start(uint16_t port)
 	networkServer->start(port);
 }
 
-void LobbyServer::run()
+void LobbyServer::run(size_t networkThreadsCount)
 {
-	networkHandler->run();
+	logGlobal->info("Running network on %d threads", networkThreadsCount);
+	networkHandler->run(networkThreadsCount);
 }
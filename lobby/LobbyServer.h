@@ -18,7 +18,12 @@ VCMI_LIB_NAMESPACE_END
 
 class LobbyDatabase;
 
-class LobbyServer final : public INetworkServerListener
+namespace boost::asio
+{
+class thread_pool;
+}
+
+class LobbyServer final : public INetworkServerListener, public INetworkTimerListener
 {
 	struct AwaitingProxyState
 	{
@@ -28,7 +33,7 @@ class LobbyServer final : public INetworkServerListener
 		NetworkConnectionWeakPtr roomConnection;
 	};
 
-	/// list of connected proxies. All messages received from (key) will be redirected to (value) connection
+	/// list of connected proxies. All data received from (key) is relayed to (value) connection
 	std::map<NetworkConnectionPtr, NetworkConnectionPtr> activeProxies;
 
 	/// list of half-established proxies from server that are still waiting for client to connect
@@ -40,10 +45,22 @@ class LobbyServer final : public INetworkServerListener
 	/// list of currently logged in game rooms (vcmiserver's)
 	std::map<NetworkConnectionPtr, std::string> activeGameRooms;
 
+	/// in-memory presence of online accounts, used to send full list to newly logged in accounts
+	std::map<std::string, LobbyAccount> onlineAccounts;
+
+	/// accounts and game rooms that have changed since last presence broadcast
+	std::set<std::string> changedAccounts;
+	std::set<std::string> changedGameRooms;
+	bool deferredUpdateScheduled = false;
+
 	std::unique_ptr<LobbyDatabase> database;
 	std::unique_ptr<INetworkHandler> networkHandler;
 	std::unique_ptr<INetworkServer> networkServer;
 
+	/// Single thread on which all lobby state and database are accessed.
+	/// Network callbacks only post work here, so slow queries do not block socket I/O of other connections
+	std::unique_ptr<boost::asio::thread_pool> databaseExecutor;
+
 	/// removes any "weird" symbols from chat message that might break UI
 	std::string sanitizeChatMessage(const std::string & inputString) const;
 
@@ -55,17 +72,32 @@ class LobbyServer final : public INetworkServerListener
 	void onNewConnection(const NetworkConnectionPtr & connection) override;
 	void onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage) override;
 	void onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message) override;
+	void onTimer() override;
 
-	void sendMessage(const NetworkConnectionPtr & target, const JsonNode & json);
-
-	void broadcastActiveAccounts();
-	void broadcastActiveGameRooms();
+	void processDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage);
+	void processPacket(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message);
 
+	void sendMessage(const NetworkConnectionPtr & target, const JsonNode & json);
+	/// Sends message to all logged in accounts, serializing it only once
+	void broadcastMessage(const JsonNode & json);
+
+	/// Queues change of account or game room for next presence update.
+	/// Changes are coalesced and sent to all accounts as single update message after short delay
+	void markAccountChanged(const std::string & accountID);
+	void markGameRoomChanged(const std::string & gameRoomID);
+	/// Schedules presence broadcast and database commit after short delay, unless already scheduled
+	void scheduleDeferredUpdate();
+	void scheduleDatabaseFlush();
+	void broadcastPresenceUpdate();
+
+	JsonNode prepareActiveAccounts();
 	JsonNode prepareActiveGameRooms();
 
 	/// Attempts to load json from incoming byte stream and validate it
 	/// Returns parsed json on success or empty json node on failure
 	JsonNode parseAndValidateMessage(const std::vector<std::byte> & message) const;
+	/// Checks whether message is login of a proxy connection. Called on network thread, before message is processed
+	bool isProxyLoginMessage(const std::vector<std::byte> & message) const;
 
 	void sendChatMessage(const NetworkConnectionPtr & target, const std::string & channelType, const std::string & channelName, const std::string & accountID, const std::string & displayName, const std::string & messageText);
 	void sendAccountCreated(const NetworkConnectionPtr & target, const std::string & accountID, const std::string & accountCookie);
@@ -100,5 +132,6 @@ public:
 	~LobbyServer();
 
 	void start(uint16_t port);
-	void run();
+	/// Runs network processing using specified number of threads. Does not return until server is stopped
+	void run(size_t networkThreadsCount);
 };
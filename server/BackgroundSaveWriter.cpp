@@ -0,0 +1,51 @@
+/*
+ * BackgroundSaveWriter.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BackgroundSaveWriter.h"
+
+#include "../lib/CThreadHelper.h"
+#include "../lib/serializer/CSaveFile.h"
+
+BackgroundSaveWriter::~BackgroundSaveWriter()
+{
+	waitForCompletion();
+}
+
+void BackgroundSaveWriter::write(std::unique_ptr<CSaveFile> save)
+{
+	waitForCompletion();
+
+	writerThread = std::make_unique<boost::thread>([save = std::shared_ptr<CSaveFile>(std::move(save))]()
+	{
+		setThreadName("saveWriter");
+
+		auto startTime = std::chrono::steady_clock::now();
+		try
+		{
+			size_t fileSize = save->writeToFile();
+
+			auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+			logGlobal->info("Game has been successfully saved! Written %d bytes (%d uncompressed) to disk in %d ms", fileSize, save->buffer.size(), duration.count());
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->error("Failed to save game: %s", e.what());
+		}
+	});
+}
+
+void BackgroundSaveWriter::waitForCompletion()
+{
+	if(!writerThread)
+		return;
+
+	writerThread->join();
+	writerThread.reset();
+}
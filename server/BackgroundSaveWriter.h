@@ -0,0 +1,30 @@
+/*
+ * BackgroundSaveWriter.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CSaveFile;
+VCMI_LIB_NAMESPACE_END
+
+/// Compresses and writes serialized savegames to disk on a separate thread, so game thread is only blocked for serialization in memory
+/// At most one save is being written at any time, new save waits for completion of previous one
+class BackgroundSaveWriter : boost::noncopyable
+{
+	std::unique_ptr<boost::thread> writerThread;
+
+public:
+	~BackgroundSaveWriter();
+
+	/// Starts writing of serialized data to file
+	void write(std::unique_ptr<CSaveFile> save);
+
+	/// Blocks until save that is being written, if any, is on disk
+	void waitForCompletion();
+};
@@ -0,0 +1,161 @@
+/*
+ * BenchmarkRecorder.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BenchmarkRecorder.h"
+
+#include "CGameHandler.h"
+
+#include "../lib/CConfigHandler.h"
+#include "../lib/CPlayerState.h"
+#include "../lib/gameState/CGameState.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/mapping/CMapHeader.h"
+#include "../lib/mapping/CMap.h"
+
+#ifdef VCMI_UNIX
+#include <sys/resource.h>
+#endif
+
+BenchmarkRecorder::BenchmarkRecorder(CGameHandler * gameHandler, const boost::filesystem::path & outputPath, int dayLimit)
+	: gameHandler(gameHandler)
+	, outputPath(outputPath)
+	, dayLimit(dayLimit)
+	, gameStart(Clock::now())
+	, battlesTotal(0)
+	, finished(false)
+{
+	logGlobal->info("Benchmark mode enabled, results will be written to %s", outputPath.string());
+}
+
+BenchmarkRecorder::~BenchmarkRecorder()
+{
+	if(!finished)
+		writeResults("aborted", PlayerColor::NEUTRAL);
+}
+
+std::unique_ptr<BenchmarkRecorder> BenchmarkRecorder::createFromSettings(CGameHandler * gameHandler)
+{
+	const JsonNode & benchmark = settings["session"]["benchmark"];
+
+	// several games may be hosted by the same process, so every game after the first one writes to its own file
+	static std::atomic<int> gamesCounter = 0;
+
+	if(benchmark["output"].String().empty())
+		return nullptr;
+
+	boost::filesystem::path outputPath = benchmark["output"].String();
+	int gameIndex = gamesCounter++;
+	if(gameIndex != 0)
+		outputPath.replace_extension(std::to_string(gameIndex) + outputPath.extension().string());
+
+	return std::make_unique<BenchmarkRecorder>(gameHandler, outputPath, benchmark["days"].Integer());
+}
+
+void BenchmarkRecorder::onPlayerTurnStarted(PlayerColor player)
+{
+	turnStarts[player] = Clock::now();
+}
+
+void BenchmarkRecorder::onPlayerTurnEnded(PlayerColor player)
+{
+	auto it = turnStarts.find(player);
+	if(it == turnStarts.end())
+		return;
+
+	std::chrono::duration<double, std::milli> duration = Clock::now() - it->second;
+	turns.push_back({static_cast<int>(gameHandler->gameState()->day), player, duration.count()});
+	turnStarts.erase(it);
+}
+
+void BenchmarkRecorder::onBattleStarted()
+{
+	battlesTotal += 1;
+}
+
+bool BenchmarkRecorder::onNewDay()
+{
+	if(dayLimit == 0 || static_cast<int>(gameHandler->gameState()->day) <= dayLimit)
+		return false;
+
+	writeResults("dayLimit", PlayerColor::NEUTRAL);
+	return true;
+}
+
+void BenchmarkRecorder::onVictory(PlayerColor winner)
+{
+	writeResults("victory", winner);
+}
+
+uint64_t BenchmarkRecorder::getPeakMemoryKilobytes()
+{
+#ifdef VCMI_UNIX
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#ifdef VCMI_APPLE
+	return usage.ru_maxrss / 1024; // reported in bytes
+#else
+	return usage.ru_maxrss; // reported in kilobytes
+#endif
+#else
+	return 0;
+#endif
+}
+
+void BenchmarkRecorder::writeResults(const std::string & result, PlayerColor winner)
+{
+	if(finished)
+		return;
+	finished = true;
+
+	const auto * gs = gameHandler->gameState();
+	std::chrono::duration<double, std::milli> gameDuration = Clock::now() - gameStart;
+
+	JsonNode output;
+	output["map"].String() = gs->map->name.toString();
+	output["result"].String() = result;
+	if(winner.isValidPlayer())
+		output["winner"].String() = winner.toString();
+	output["days"].Integer() = gs->day;
+	output["battles"].Integer() = battlesTotal;
+	output["wallTimeMs"].Float() = gameDuration.count();
+	output["peakMemoryKb"].Integer() = getPeakMemoryKilobytes();
+
+	std::map<PlayerColor, std::vector<double>> playerTurns;
+	for(const auto & turn : turns)
+	{
+		JsonNode entry;
+		entry["day"].Integer() = turn.day;
+		entry["player"].String() = turn.player.toString();
+		entry["timeMs"].Float() = turn.durationMilliseconds;
+		output["turns"].Vector().push_back(entry);
+
+		playerTurns[turn.player].push_back(turn.durationMilliseconds);
+	}
+
+	for(auto & [player, durations] : playerTurns)
+	{
+		JsonNode & entry = output["players"][player.toString()];
+		const auto * state = gs->getPlayerState(player, false);
+
+		std::sort(durations.begin(), durations.end());
+		entry["human"].Bool() = state && state->isHuman();
+		entry["turns"].Integer() = durations.size();
+		entry["totalTimeMs"].Float() = std::accumulate(durations.begin(), durations.end(), 0.0);
+		entry["medianTimeMs"].Float() = durations[durations.size() / 2];
+		entry["maxTimeMs"].Float() = durations.back();
+	}
+
+	std::ofstream file(outputPath.c_str());
+	file << output.toString();
+
+	logGlobal->info("Benchmark finished (%s) after %d days, results written to %s", result, gs->day, outputPath.string());
+}
@@ -0,0 +1,57 @@
+/*
+ * BenchmarkRecorder.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/constants/EntityIdentifiers.h"
+
+class CGameHandler;
+
+/// Collects per-turn timings and other statistics of AI-only games and writes them as json file.
+/// Active if benchmark output file was requested, via command line of server or client
+class BenchmarkRecorder : boost::noncopyable
+{
+	struct TurnRecord
+	{
+		int day;
+		PlayerColor player;
+		double durationMilliseconds;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	CGameHandler * gameHandler;
+	boost::filesystem::path outputPath;
+	int dayLimit;
+
+	Clock::time_point gameStart;
+	std::map<PlayerColor, Clock::time_point> turnStarts;
+	std::vector<TurnRecord> turns;
+	int battlesTotal;
+
+	bool finished;
+
+	static uint64_t getPeakMemoryKilobytes();
+	void writeResults(const std::string & result, PlayerColor winner);
+
+public:
+	BenchmarkRecorder(CGameHandler * gameHandler, const boost::filesystem::path & outputPath, int dayLimit);
+	~BenchmarkRecorder();
+
+	/// Creates recorder if benchmark was requested in session settings, or returns nullptr otherwise
+	static std::unique_ptr<BenchmarkRecorder> createFromSettings(CGameHandler * gameHandler);
+
+	void onPlayerTurnStarted(PlayerColor player);
+	void onPlayerTurnEnded(PlayerColor player);
+	void onBattleStarted();
+
+	/// Returns true if day limit has been reached and game should end
+	bool onNewDay();
+	void onVictory(PlayerColor winner);
+};
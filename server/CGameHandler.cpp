@@ -11,6 +11,9 @@
 #include "CGameHandler.h"
 
 #include "CVCMIServer.h"
+#include "BackgroundSaveWriter.h"
+#include "BenchmarkRecorder.h"
+#include "StatisticsStreamer.h"
 #include "TurnTimerHandler.h"
 #include "ServerNetPackVisitors.h"
 #include "ServerSpellCastEnvironment.h"
@@ -41,6 +44,7 @@
 #include "../lib/StartInfo.h"
 #include "../lib/TerrainHandler.h"
 #include "../lib/VCMIDirs.h"
+#include "../lib/TraceProfiler.h"
 #include "../lib/VCMI_Lib.h"
 #include "../lib/int3.h"
 
@@ -441,6 +445,8 @@ void CGameHandler::handleClientDisconnection(std::shared_ptr<CConnection> c)
 
 void CGameHandler::handleReceivedPack(CPackForServer * pack)
 {
+	VCMI_PROFILE_ZONE("CGameHandler::handleReceivedPack");
+
 	//prepare struct informing that action was applied
 	auto sendPackageResponse = [&](bool successfullyApplied)
 	{
@@ -494,6 +500,7 @@ CGameHandler::CGameHandler(CVCMIServer * lobby)
 	, complainInvalidSlot("Invalid slot accessed!")
 	, turnTimerHandler(std::make_unique<TurnTimerHandler>(*this))
 	, newTurnProcessor(std::make_unique<NewTurnProcessor>(this))
+	, saveWriter(std::make_unique<BackgroundSaveWriter>())
 {
 	QID = 1;
 
@@ -502,6 +509,7 @@ CGameHandler::CGameHandler(CVCMIServer * lobby)
 
 CGameHandler::~CGameHandler()
 {
+	benchmark.reset(); // writes results using game state
 	delete spellEnv;
 	delete gs;
 	gs = nullptr;
@@ -516,13 +524,18 @@ void CGameHandler::reinitScripting()
 }
 
 void CGameHandler::init(StartInfo *si, Load::ProgressAccumulator & progressTracking)
+{
+	CMapService mapService;
+	init(si, progressTracking, mapService);
+}
+
+void CGameHandler::init(StartInfo *si, Load::ProgressAccumulator & progressTracking, const IMapService & mapService)
 {
 	int requestedSeed = settings["server"]["seed"].Integer();
 	if (requestedSeed != 0)
 		randomNumberGenerator->setSeed(requestedSeed);
 	logGlobal->info("Using random seed: %d", randomNumberGenerator->nextInt());
 
-	CMapService mapService;
 	gs = new CGameState();
 	gs->preInit(VLC, this);
 	logGlobal->info("Gamestate created!");
@@ -532,6 +545,9 @@ void CGameHandler::init(StartInfo *si, Load::ProgressAccumulator & progressTrack
 	for (auto & elem : gs->players)
 		turnOrder->addPlayer(elem.first);
 
+	benchmark = BenchmarkRecorder::createFromSettings(this);
+	statisticsStreamer = StatisticsStreamer::createFromSettings();
+
 	for (auto & elem : gs->map->allHeroes)
 	{
 		if(elem)
@@ -585,6 +601,9 @@ void CGameHandler::setPortalDwelling(const CGTownInstance * town, bool forced=fa
 
 void CGameHandler::onPlayerTurnStarted(PlayerColor which)
 {
+	if (benchmark)
+		benchmark->onPlayerTurnStarted(which);
+
 	events::PlayerGotTurn::defaultExecute(serverEventBus.get(), which);
 	turnTimerHandler->onPlayerGetTurn(which);
 	newTurnProcessor->onPlayerTurnStarted(which);
@@ -593,6 +612,9 @@ void CGameHandler::onPlayerTurnStarted(PlayerColor which)
 void CGameHandler::onPlayerTurnEnded(PlayerColor which)
 {
 	newTurnProcessor->onPlayerTurnEnded(which);
+
+	if (benchmark)
+		benchmark->onPlayerTurnEnded(which);
 }
 
 void CGameHandler::addStatistics(StatisticDataSet &stat) const
@@ -632,6 +654,8 @@ void CGameHandler::onNewTurn()
 	else
 	{
 		addStatistics(gameState()->statistic); // write at end of turn
+		if (statisticsStreamer)
+			statisticsStreamer->onStatisticsAdded(gameState()->statistic, getDate(Date::DAY));
 	}
 
 	for (CGTownInstance *t : gs->map->towns)
@@ -674,6 +698,9 @@ void CGameHandler::onNewTurn()
 	if (!firstTurn)
 		checkVictoryLossConditionsForAll(); // check for map turn limit
 
+	if (benchmark && benchmark->onNewDay())
+		lobby->setState(EServerState::SHUTDOWN);
+
 	//call objects
 	for (auto & elem : gs->map->objects)
 	{
@@ -1507,13 +1534,19 @@ void CGameHandler::save(const std::string & filename)
 
 	try
 	{
-		{
-			CSaveFile save(*CResourceHandler::get("local")->getResourceName(savePath));
-			saveCommonState(save);
-			logGlobal->info("Saving server state");
-			save << *this;
-		}
-		logGlobal->info("Game has been successfully saved!");
+		auto startTime = std::chrono::steady_clock::now();
+
+		auto save = std::make_unique<CSaveFile>(*CResourceHandler::get("local")->getResourceName(savePath));
+		saveCommonState(*save);
+		logGlobal->info("Saving server state");
+		save->beginSection();
+		*save << *this;
+
+		// game is blocked only while serializing into memory, compression and disk I/O are done in background
+		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+		logGlobal->info("Game state serialized in %d ms (%d bytes), writing to disk in background", duration.count(), save->buffer.size());
+
+		saveWriter->write(std::move(save));
 	}
 	catch(std::exception &e)
 	{
@@ -1528,16 +1561,22 @@ bool CGameHandler::load(const std::string & filename)
 
 	reinitScripting();
 
+	// file might still be written by previous save
+	saveWriter->waitForCompletion();
+
 	try
 	{
+		auto startTime = std::chrono::steady_clock::now();
 		{
 			CLoadFile lf(*CResourceHandler::get()->getResourceName(ResourcePath(stem.to_string(), EResType::SAVEGAME)), ESerializationVersion::MINIMAL);
 			lf.serializer.cb = this;
+			lf.decompressAllSections();
 			loadCommonState(lf);
 			logGlobal->info("Loading server state");
 			lf >> *this;
 		}
-		logGlobal->info("Game has been successfully loaded!");
+		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+		logGlobal->info("Game has been successfully loaded in %d ms!", duration.count());
 	}
 	catch(const ModIncompatibility & e)
 	{
@@ -1574,6 +1613,7 @@ bool CGameHandler::load(const std::string & filename)
 	}
 	gs->preInit(VLC, this);
 	gs->updateOnLoad(lobby->si.get());
+	statisticsStreamer = StatisticsStreamer::createFromSettings();
 	return true;
 }
 
@@ -3380,7 +3420,10 @@ void CGameHandler::checkVictoryLossConditionsForPlayer(PlayerColor player)
 				}
 			}
 
-			if(p->human)
+			if (benchmark)
+				benchmark->onVictory(player);
+
+			if(p->human || benchmark)
 			{
 				lobby->setState(EServerState::SHUTDOWN);
 			}
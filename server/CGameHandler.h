@@ -19,6 +19,7 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 struct SideInBattle;
+class IMapService;
 class IMarket;
 class SpellCastEnvironment;
 class CConnection;
@@ -52,6 +53,9 @@ class TurnTimerHandler;
 class QueriesProcessor;
 class CObjectVisitQuery;
 class NewTurnProcessor;
+class BenchmarkRecorder;
+class StatisticsStreamer;
+class BackgroundSaveWriter;
 
 class CGameHandler : public IGameCallback, public Environment
 {
@@ -65,6 +69,9 @@ public:
 	std::unique_ptr<TurnTimerHandler> turnTimerHandler;
 	std::unique_ptr<NewTurnProcessor> newTurnProcessor;
 	std::unique_ptr<CRandomGenerator> randomNumberGenerator;
+	std::unique_ptr<BenchmarkRecorder> benchmark;
+	std::unique_ptr<StatisticsStreamer> statisticsStreamer;
+	std::unique_ptr<BackgroundSaveWriter> saveWriter;
 
 	//use enums as parameters, because doMove(sth, true, false, true) is not readable
 	enum EGuardLook {CHECK_FOR_GUARDS, IGNORE_GUARDS};
@@ -192,6 +199,8 @@ public:
 	//////////////////////////////////////////////////////////////////////////
 
 	void init(StartInfo *si, Load::ProgressAccumulator & progressTracking);
+	/// Initializes game state using map provided by specified map service instead of map files
+	void init(StartInfo *si, Load::ProgressAccumulator & progressTracking, const IMapService & mapService);
 	void handleClientDisconnection(std::shared_ptr<CConnection> c);
 	void handleReceivedPack(CPackForServer * pack);
 	bool hasPlayerAt(PlayerColor player, std::shared_ptr<CConnection> c) const;
@@ -0,0 +1,58 @@
+/*
+ * StatisticsStreamer.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "StatisticsStreamer.h"
+
+#include "../lib/CConfigHandler.h"
+#include "../lib/gameState/GameStatistics.h"
+#include "../lib/json/JsonNode.h"
+#include <vstd/DateUtils.h>
+
+static const std::string csvSeparator = ";";
+
+StatisticsStreamer::StatisticsStreamer(const boost::filesystem::path & outputPath, int keptDays)
+	: file(outputPath.c_str())
+	, keptDays(keptDays)
+{
+	if(!file)
+		throw std::runtime_error("Failed to open statistics file " + outputPath.string());
+
+	logGlobal->info("Streaming game statistics to %s, keeping last %d days in game state", outputPath.string(), keptDays);
+	file << StatisticDataSet::toCsvHeader(csvSeparator);
+}
+
+std::unique_ptr<StatisticsStreamer> StatisticsStreamer::createFromSettings()
+{
+	// several games may be hosted by the same process, so file name must be unique
+	static std::atomic<int> gamesCounter = 0;
+
+	const JsonNode & statistics = settings["session"]["statistics"];
+
+	if(statistics["output"].String().empty())
+		return nullptr;
+
+	const boost::filesystem::path outputDirectory = statistics["output"].String();
+	boost::filesystem::create_directories(outputDirectory);
+
+	std::string fileName = vstd::getDateTimeISO8601Basic(std::time(nullptr)) + "_" + std::to_string(gamesCounter++) + ".csv";
+	int keptDays = statistics["keepDays"].isNull() ? 7 : statistics["keepDays"].Integer();
+
+	return std::make_unique<StatisticsStreamer>(outputDirectory / fileName, keptDays);
+}
+
+void StatisticsStreamer::onStatisticsAdded(StatisticDataSet & statistic, int day)
+{
+	for(const auto & entry : statistic.data)
+		if(entry.day == day)
+			file << StatisticDataSet::toCsvRow(entry, csvSeparator);
+
+	file.flush();
+	statistic.removeDaysBefore(day - keptDays + 1);
+}
@@ -0,0 +1,31 @@
+/*
+ * StatisticsStreamer.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+class StatisticDataSet;
+VCMI_LIB_NAMESPACE_END
+
+/// Writes game statistics to csv file as soon as they are collected, instead of keeping entire history in game state.
+/// Active if statistics output directory was requested via command line of server
+class StatisticsStreamer : boost::noncopyable
+{
+	std::ofstream file;
+	int keptDays;
+
+public:
+	StatisticsStreamer(const boost::filesystem::path & outputPath, int keptDays);
+
+	/// Creates streamer if statistics output was requested in session settings, or returns nullptr otherwise
+	static std::unique_ptr<StatisticsStreamer> createFromSettings();
+
+	/// Writes all entries of specified day and removes entries that are too old to be kept in memory and in saved games
+	void onStatisticsAdded(StatisticDataSet & statistic, int day);
+};
@@ -14,6 +14,7 @@
 #include "BattleFlowProcessor.h"
 #include "BattleResultProcessor.h"
 
+#include "../BenchmarkRecorder.h"
 #include "../CGameHandler.h"
 #include "../queries/QueriesProcessor.h"
 #include "../queries/BattleQueries.h"
@@ -140,6 +141,9 @@ void BattleProcessor::startBattle(const CArmedInstance *army1, const CArmedInsta
 		gameHandler->queries->addQuery(newBattleQuery);
 	}
 
+	if (gameHandler->benchmark)
+		gameHandler->benchmark->onBattleStarted();
+
 	flowProcessor->onBattleStarted(*battle);
 }
 
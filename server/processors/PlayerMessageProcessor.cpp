@@ -19,6 +19,7 @@
 #include "../../lib/CHeroHandler.h"
 #include "../../lib/CPlayerState.h"
 #include "../../lib/StartInfo.h"
+#include "../../lib/TraceProfiler.h"
 #include "../../lib/entities/building/CBuilding.h"
 #include "../../lib/gameState/CGameState.h"
 #include "../../lib/mapObjects/CGTownInstance.h"
@@ -146,6 +147,37 @@ void PlayerMessageProcessor::commandStatistic(PlayerColor player, const std::vec
 	broadcastSystemMessage("Statistic files can be found in " + path + " directory\n");
 }
 
+void PlayerMessageProcessor::commandProfiler(PlayerColor player, const std::vector<std::string> & words)
+{
+	bool isHost = gameHandler->gameLobby()->isPlayerHost(player);
+	if(!isHost || words.size() != 2)
+		return;
+
+	if(words[1] == "start")
+	{
+		TraceProfiler::get().start();
+		broadcastSystemMessage("Server profiler started");
+	}
+	if(words[1] == "stop")
+	{
+		TraceProfiler::get().stop();
+		broadcastSystemMessage("Server profiler stopped");
+	}
+	if(words[1] == "dump")
+	{
+		try
+		{
+			std::string path = TraceProfiler::get().dump();
+			broadcastSystemMessage("Server profiler data saved to " + path);
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->error("Failed to save profiler data: %s", e.what());
+			broadcastSystemMessage("Failed to save server profiler data: " + std::string(e.what()));
+		}
+	}
+}
+
 void PlayerMessageProcessor::commandHelp(PlayerColor player, const std::vector<std::string> & words)
 {
 	broadcastSystemMessage("Available commands to host:");
@@ -153,6 +185,7 @@ void PlayerMessageProcessor::commandHelp(PlayerColor player, const std::vector<s
 	broadcastSystemMessage("'!kick <player>' - kick specified player from the game");
 	broadcastSystemMessage("'!save <filename>' - save game under specified filename");
 	broadcastSystemMessage("'!statistic' - save game statistics as csv file");
+	broadcastSystemMessage("'!profiler <start|stop|dump>' - control server trace profiler");
 	broadcastSystemMessage("Available commands to all players:");
 	broadcastSystemMessage("'!help' - display this help");
 	broadcastSystemMessage("'!cheaters' - list players that entered cheat command during game");
@@ -335,6 +368,8 @@ void PlayerMessageProcessor::handleCommand(PlayerColor player, const std::string
 		commandCheaters(player, words);
 	if(words[0] == "!statistic")
 		commandStatistic(player, words);
+	if(words[0] == "!profiler")
+		commandProfiler(player, words);
 }
 
 void PlayerMessageProcessor::cheatGiveSpells(PlayerColor player, const CGHeroInstance * hero)
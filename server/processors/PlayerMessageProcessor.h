@@ -64,6 +64,7 @@ class PlayerMessageProcessor
 	void commandSave(PlayerColor player, const std::vector<std::string> & words);
 	void commandCheaters(PlayerColor player, const std::vector<std::string> & words);
 	void commandStatistic(PlayerColor player, const std::vector<std::string> & words);
+	void commandProfiler(PlayerColor player, const std::vector<std::string> & words);
 	void commandHelp(PlayerColor player, const std::vector<std::string> & words);
 	void commandVote(PlayerColor player, const std::vector<std::string> & words);
 
@@ -121,37 +121,66 @@ bool TurnOrderProcessor::playersInContact(PlayerColor left, PlayerColor right) c
 		}
 	}
 
-	for(const auto & hero : leftInfo->getHeroes())
-	{
-		CPathsInfo out(mapSize, hero);
-		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameHandler->gameState(), hero);
-		config->options.ignoreGuards = true;
-		config->options.turnLimit = 1;
-		CPathfinder pathfinder(gameHandler->gameState(), config);
-		pathfinder.calculatePaths();
-
-		for (int z = 0; z < mapSize.z; ++z)
-			for (int y = 0; y < mapSize.y; ++y)
-				for (int x = 0; x < mapSize.x; ++x)
-					if (out.getNode({x,y,z})->reachable())
-						leftReachability[z][x][y] = true;
-	}
+	// heroes are processed in batches that run in parallel, node storage is reused between batches to limit memory usage
+	size_t batchSize = std::max<size_t>(1, boost::thread::hardware_concurrency());
+	std::vector<std::unique_ptr<CPathsInfo>> paths;
 
-	for(const auto & hero : rightInfo->getHeroes())
+	auto addHeroesReachability = [&](const std::vector<const CGHeroInstance *> & heroes, boost::multi_array<bool, 3> & reachability, const std::shared_ptr<const std::unordered_set<int3>> & targetTiles)
 	{
-		CPathsInfo out(mapSize, hero);
-		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameHandler->gameState(), hero);
-		config->options.ignoreGuards = true;
-		config->options.turnLimit = 1;
-		CPathfinder pathfinder(gameHandler->gameState(), config);
-		pathfinder.calculatePaths();
-
-		for (int z = 0; z < mapSize.z; ++z)
-			for (int y = 0; y < mapSize.y; ++y)
-				for (int x = 0; x < mapSize.x; ++x)
-					if (out.getNode({x,y,z})->reachable())
-						rightReachability[z][x][y] = true;
-	}
+		for(size_t batchStart = 0; batchStart < heroes.size(); batchStart += batchSize)
+		{
+			size_t batchEnd = std::min(heroes.size(), batchStart + batchSize);
+			std::vector<std::shared_ptr<PathfinderConfig>> configs;
+
+			for(size_t i = batchStart; i < batchEnd; ++i)
+			{
+				const auto * hero = heroes[i];
+				size_t storageIndex = i - batchStart;
+
+				if(storageIndex < paths.size())
+					paths[storageIndex]->reset(hero);
+				else
+					paths.push_back(std::make_unique<CPathsInfo>(mapSize, hero));
+
+				auto config = std::make_shared<SingleHeroPathfinderConfig>(*paths[storageIndex], gameHandler->gameState(), hero);
+				config->options.ignoreGuards = true;
+				config->options.turnLimit = 1;
+				config->options.targetTiles = targetTiles;
+				config->options.targetTilesToReach = 1;
+				configs.push_back(config);
+			}
+
+			gameHandler->gameState()->calculatePaths(configs);
+
+			for(size_t i = batchStart; i < batchEnd; ++i)
+			{
+				const auto & out = *paths[i - batchStart];
+
+				for (int z = 0; z < mapSize.z; ++z)
+					for (int y = 0; y < mapSize.y; ++y)
+						for (int x = 0; x < mapSize.x; ++x)
+							if (out.getNode({x,y,z})->reachable())
+								reachability[z][x][y] = true;
+			}
+		}
+	};
+
+	// area reachable by right player is computed completely
+	addHeroesReachability(rightInfo->getHeroes(), rightReachability, nullptr);
+
+	auto rightReachableTiles = std::make_shared<std::unordered_set<int3>>();
+	for (int z = 0; z < mapSize.z; ++z)
+		for (int y = 0; y < mapSize.y; ++y)
+			for (int x = 0; x < mapSize.x; ++x)
+				if (rightReachability[z][x][y])
+					rightReachableTiles->insert({x,y,z});
+
+	// empty target list would mean unrestricted search
+	if (rightReachableTiles->empty())
+		return false;
+
+	// for heroes of left player it is enough to find whether any of these tiles is reachable, so search stops on first reached tile
+	addHeroesReachability(leftInfo->getHeroes(), leftReachability, rightReachableTiles);
 
 	for (int z = 0; z < mapSize.z; ++z)
 		for (int y = 0; y < mapSize.y; ++y)
@@ -183,12 +212,13 @@ bool TurnOrderProcessor::computeCanActSimultaneously(PlayerColor active, PlayerC
 		if (!gameHandler->getStartInfo()->simturnsInfo.allowHumanWithAI)
 			return false;
 	}
-	else
+	else if (activeInfo->human)
 	{
-		// two AI or two humans in hotseat can't play at the same time
+		// two humans in hotseat can't play at the same time
 		if (gameHandler->hasBothPlayersAtSameConnection(active, waiting))
 			return false;
 	}
+	// AI players hosted on the same client make their turns in separate threads and can act simultaneously
 
 	if (gameHandler->getDate(Date::DAY) < simturnsTurnsMinLimit())
 		return true;
@@ -30,9 +30,10 @@ CQuery::CQuery(CGameHandler * gameHandler)
 	: owner(gameHandler->queries.get())
 	, gh(gameHandler)
 {
-	static QueryID QID = QueryID(0);
+	// shared by all game rooms hosted by this process
+	static std::atomic<int32_t> QID = 0;
 
-	queryID = ++QID;
+	queryID = QueryID(++QID);
 	logGlobal->trace("Created a new query with id %d", queryID);
 }
 
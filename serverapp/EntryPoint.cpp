@@ -16,6 +16,7 @@
 #include "../lib/VCMIDirs.h"
 #include "../lib/VCMI_Lib.h"
 #include "../lib/CConfigHandler.h"
+#include "../lib/CThreadHelper.h"
 
 #include <boost/program_options.hpp>
 
@@ -30,7 +31,12 @@ static void handleCommandOptions(int argc, const char * argv[], boost::program_o
 	("version,v", "display version information and exit")
 	("run-by-client", "indicate that server launched by client on same machine")
 	("port", boost::program_options::value<ui16>(), "port at which server will listen to connections from client")
-	("lobby", "start server in lobby mode in which server connects to a global lobby");
+	("lobby", "start server in lobby mode in which server connects to a global lobby")
+	("rooms", boost::program_options::value<int>(), "host specified number of independent game rooms in this process. Without lobby mode rooms listen on consecutive ports")
+	("benchmark-output", boost::program_options::value<std::string>(), "write per-turn timings and other game statistics to specified json file")
+	("benchmark-days", boost::program_options::value<int>(), "end benchmarked game after specified number of days")
+	("statistics-output", boost::program_options::value<std::string>(), "write game statistics as csv files to specified directory as soon as they are collected")
+	("statistics-keep-days", boost::program_options::value<int>(), "when statistics output is active, keep statistics only for specified number of last days in game state. Default is 7");
 
 	if(argc > 1)
 	{
@@ -66,6 +72,32 @@ static void handleCommandOptions(int argc, const char * argv[], boost::program_o
 	}
 }
 
+/// Hosts single game room, starting new server instance whenever game in it ends
+/// All rooms share content loaded into VLC while each of them has own game state and connections
+static void runGameRoom(int roomIndex, uint16_t port, bool connectToLobby)
+{
+	setThreadName("room" + std::to_string(roomIndex));
+
+	for(;;)
+	{
+		try
+		{
+			CVCMIServer server(port, false);
+			server.prepare(connectToLobby);
+			server.run();
+		}
+		catch(const std::exception & e)
+		{
+			// failure in one room must not bring down other rooms
+			logGlobal->error("Game room %d has been terminated due to error: %s", roomIndex, e.what());
+			// avoid busy loop if room can not be started, e.g. due to unavailable port
+			boost::this_thread::sleep_for(boost::chrono::seconds(1));
+		}
+
+		logGlobal->info("Game room %d has finished, restarting", roomIndex);
+	}
+}
+
 int main(int argc, const char * argv[])
 {
 	// Correct working dir executable folder (not bundle folder) so we can use executable relative paths
@@ -81,6 +113,22 @@ int main(int argc, const char * argv[])
 	preinitDLL(console, false);
 	logConfig.configure();
 
+	if(opts.count("benchmark-output"))
+	{
+		Settings benchmark = settings.write["session"]["benchmark"];
+		benchmark["output"].String() = opts["benchmark-output"].as<std::string>();
+		if(opts.count("benchmark-days"))
+			benchmark["days"].Integer() = opts["benchmark-days"].as<int>();
+	}
+
+	if(opts.count("statistics-output"))
+	{
+		Settings statistics = settings.write["session"]["statistics"];
+		statistics["output"].String() = opts["statistics-output"].as<std::string>();
+		if(opts.count("statistics-keep-days"))
+			statistics["keepDays"].Integer() = opts["statistics-keep-days"].as<int>();
+	}
+
 	loadDLLClasses();
 	std::srand(static_cast<uint32_t>(time(nullptr)));
 
@@ -91,9 +139,28 @@ int main(int argc, const char * argv[])
 		if(opts.count("port"))
 			port = opts["port"].as<uint16_t>();
 
-		CVCMIServer server(port, runByClient);
-		server.prepare(connectToLobby);
-		server.run();
+		int roomsCount = opts.count("rooms") ? opts["rooms"].as<int>() : 0;
+
+		if(roomsCount > 0)
+		{
+			logGlobal->info("Hosting %d game rooms", roomsCount);
+
+			std::vector<boost::thread> rooms;
+			for(int i = 0; i < roomsCount; ++i)
+			{
+				uint16_t roomPort = connectToLobby ? 0 : port + i;
+				rooms.emplace_back(&runGameRoom, i, roomPort, connectToLobby);
+			}
+
+			for(auto & room : rooms)
+				room.join();
+		}
+		else
+		{
+			CVCMIServer server(port, runByClient);
+			server.prepare(connectToLobby);
+			server.run();
+		}
 
 		// CVCMIServer destructor must be called here - before VLC cleanup
 	}
@@ -14,7 +14,7 @@
 TEST(BattleHexTest, getNeighbouringTiles)
 {
 	BattleHex mainHex;
-	std::vector<BattleHex> neighbouringTiles;
+	BattleHexNeighbours neighbouringTiles;
 	mainHex.setXY(16,0);
 	neighbouringTiles = mainHex.neighbouringTiles();
 	EXPECT_EQ(neighbouringTiles.size(), 1);
@@ -0,0 +1,132 @@
+/*
+ * BattleSimulatorTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "BattleScenario.h"
+#include "BattleSimulator.h"
+
+#include "../../lib/StartInfo.h"
+
+namespace test
+{
+
+class BattleScenarioTest : public ::testing::Test
+{
+public:
+	static JsonNode makeHero(const std::string & type, const std::string & creature, int amount)
+	{
+		JsonNode stack;
+		stack["type"].String() = creature;
+		stack["amount"].Integer() = amount;
+
+		JsonNode hero;
+		hero["type"].String() = type;
+		hero["army"].Vector().push_back(stack);
+		return hero;
+	}
+
+	static JsonNode makeScenario()
+	{
+		JsonNode scenario;
+		scenario["terrain"].String() = "grass";
+		scenario["attacker"]["hero"] = makeHero("orrin", "pikeman", 20);
+		scenario["defender"]["ai"].String() = "StupidAI";
+		scenario["defender"]["hero"] = makeHero("crag", "goblin", 50);
+		return scenario;
+	}
+};
+
+TEST_F(BattleScenarioTest, ParsesSides)
+{
+	BattleScenario scenario(makeScenario());
+
+	EXPECT_EQ(scenario.getAIName(BattleSide::ATTACKER), "BattleAI");
+	EXPECT_EQ(scenario.getAIName(BattleSide::DEFENDER), "StupidAI");
+
+	scenario.setAIName(BattleSide::ATTACKER, "StupidAI");
+	EXPECT_EQ(scenario.getAIName(BattleSide::ATTACKER), "StupidAI");
+
+	EXPECT_EQ(BattleScenario::sideToPlayer(BattleSide::ATTACKER), PlayerColor(0));
+	EXPECT_EQ(BattleScenario::sideToPlayer(BattleSide::DEFENDER), PlayerColor(1));
+}
+
+TEST_F(BattleScenarioTest, CreatesStartInfo)
+{
+	JsonNode config = makeScenario();
+	config["difficulty"].Integer() = 3;
+
+	StartInfo si = BattleScenario(config).createStartInfo();
+
+	EXPECT_EQ(si.mode, EStartMode::NEW_GAME);
+	EXPECT_EQ(si.difficulty, 3);
+	ASSERT_EQ(si.playerInfos.size(), 2);
+
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+	{
+		const PlayerSettings & pset = si.getIthPlayersSettings(BattleScenario::sideToPlayer(side));
+		EXPECT_EQ(pset.color, BattleScenario::sideToPlayer(side));
+		EXPECT_TRUE(pset.compOnly);
+		EXPECT_EQ(pset.bonus, PlayerStartingBonus::GOLD);
+	}
+
+	EXPECT_EQ(BattleScenario(makeScenario()).createStartInfo().difficulty, 1);
+}
+
+TEST_F(BattleScenarioTest, RejectsInvalidSides)
+{
+	JsonNode noAttacker = makeScenario();
+	noAttacker["attacker"]["hero"].clear();
+	EXPECT_THROW(BattleScenario{noAttacker}, std::runtime_error);
+
+	JsonNode attackerTown = makeScenario();
+	attackerTown["attacker"]["town"]["type"].String() = "castle";
+	EXPECT_THROW(BattleScenario{attackerTown}, std::runtime_error);
+
+	JsonNode noDefender = makeScenario();
+	noDefender["defender"]["hero"].clear();
+	EXPECT_THROW(BattleScenario{noDefender}, std::runtime_error);
+
+	JsonNode defenderTown = noDefender;
+	defenderTown["defender"]["town"]["type"].String() = "stronghold";
+	EXPECT_NO_THROW(BattleScenario{defenderTown});
+}
+
+TEST_F(BattleScenarioTest, SimulationIsDeterministic)
+{
+	BattleScenario scenario(makeScenario());
+	scenario.setAIName(BattleSide::ATTACKER, "StupidAI");
+
+	const auto & simulate = [&scenario]()
+	{
+		BattleSimulator simulator(scenario);
+		simulator.run(3, 1);
+		return simulator.getReport();
+	};
+
+	JsonNode first = simulate();
+	JsonNode second = simulate();
+
+	EXPECT_EQ(first["battles"].Integer(), 3);
+	EXPECT_EQ(first["aborted"].Integer(), 0);
+	EXPECT_EQ(first["draws"].Integer(), second["draws"].Integer());
+	EXPECT_EQ(first["averageRounds"].Float(), second["averageRounds"].Float());
+
+	for(const auto * side : {"attacker", "defender"})
+	{
+		EXPECT_EQ(first[side]["victories"].Integer(), second[side]["victories"].Integer());
+		EXPECT_EQ(first[side]["averageCasualties"].Float(), second[side]["averageCasualties"].Float());
+		EXPECT_EQ(first[side]["decisionTimes"]["decisions"].Integer(), second[side]["decisionTimes"]["decisions"].Integer());
+	}
+
+	EXPECT_EQ(first["attacker"]["victories"].Integer() + first["defender"]["victories"].Integer() + first["draws"].Integer(), 3);
+}
+
+}
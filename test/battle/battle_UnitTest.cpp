@@ -17,7 +17,9 @@ TEST(battle_Unit_getSurroundingHexes, oneWide)
 
 	auto actual = battle::Unit::getSurroundingHexes(position, false, BattleSide::ATTACKER);
 
-	EXPECT_EQ(actual, position.neighbouringTiles());
+	const auto & expected = position.neighbouringTiles();
+
+	EXPECT_EQ(actual, std::vector<BattleHex>(expected.begin(), expected.end()));
 }
 
 TEST(battle_Unit_getSurroundingHexes, oneWideLeftCorner)
@@ -26,7 +28,9 @@ TEST(battle_Unit_getSurroundingHexes, oneWideLeftCorner)
 
 	auto actual = battle::Unit::getSurroundingHexes(position, false, BattleSide::ATTACKER);
 
-	EXPECT_EQ(actual, position.neighbouringTiles());
+	const auto & expected = position.neighbouringTiles();
+
+	EXPECT_EQ(actual, std::vector<BattleHex>(expected.begin(), expected.end()));
 }
 
 TEST(battle_Unit_getSurroundingHexes, oneWideRightCorner)
@@ -35,7 +39,9 @@ TEST(battle_Unit_getSurroundingHexes, oneWideRightCorner)
 
 	auto actual = battle::Unit::getSurroundingHexes(position, false, BattleSide::ATTACKER);
 
-	EXPECT_EQ(actual, position.neighbouringTiles());
+	const auto & expected = position.neighbouringTiles();
+
+	EXPECT_EQ(actual, std::vector<BattleHex>(expected.begin(), expected.end()));
 }
 
 TEST(battle_Unit_getSurroundingHexes, doubleWideAttacker)
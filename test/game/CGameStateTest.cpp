@@ -22,6 +22,7 @@
 #include "../../lib/networkPacks/SetStackEffect.h"
 #include "../../lib/StartInfo.h"
 #include "../../lib/TerrainHandler.h"
+#include "../../lib/VCMI_Lib.h"
 
 #include "../../lib/battle/BattleInfo.h"
 #include "../../lib/battle/BattleLayout.h"
@@ -29,8 +30,13 @@
 
 #include "../../lib/filesystem/ResourcePath.h"
 
+#include "../../lib/mapObjectConstructors/AObjectTypeHandler.h"
+#include "../../lib/mapObjectConstructors/CObjectClassesHandler.h"
 #include "../../lib/mapping/CMap.h"
 
+#include "../../lib/pathfinder/CGPathNode.h"
+#include "../../lib/pathfinder/PathfinderOptions.h"
+
 #include "../../lib/spells/CSpellHandler.h"
 #include "../../lib/spells/ISpellMechanics.h"
 #include "../../lib/spells/AbilityCaster.h"
@@ -401,3 +407,346 @@ TEST_F(CGameStateTest, DISABLED_battleResurrection)
 	EXPECT_EQ(unit->health.getCount(), 10);
 	EXPECT_EQ(unit->health.getResurrected(), 0);
 }
+
+TEST_F(CGameStateTest, pathfinderStopsOnTargetsWithOptimalPaths)
+{
+	startTestGame();
+
+	const CGHeroInstance * hero = map->heroesOnMap[0];
+	const int3 mapSize = gameState->getMapSize();
+
+	CPathsInfo fullPaths(mapSize, hero);
+	gameState->calculatePaths(hero, fullPaths);
+
+	std::vector<int3> reachableTiles;
+	for(int z = 0; z < mapSize.z; ++z)
+		for(int y = 0; y < mapSize.y; ++y)
+			for(int x = 0; x < mapSize.x; ++x)
+				if(fullPaths.getNode({x, y, z})->reachable())
+					reachableTiles.emplace_back(x, y, z);
+
+	ASSERT_FALSE(reachableTiles.empty());
+
+	auto calculatePathsTo = [&](CPathsInfo & out, const std::unordered_set<int3> & targets, size_t targetsToReach)
+	{
+		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameState.get(), hero);
+		config->options.targetTiles = std::make_shared<std::unordered_set<int3>>(targets);
+		config->options.targetTilesToReach = targetsToReach;
+		gameState->calculatePaths(config);
+	};
+
+	auto expectSameNode = [&](const CPathsInfo & partialPaths, const int3 & tile)
+	{
+		const auto * expected = fullPaths.getNode(tile);
+		const auto * actual = partialPaths.getNode(tile);
+
+		ASSERT_TRUE(actual->reachable()) << tile.toString();
+		EXPECT_EQ(actual->layer, expected->layer) << tile.toString();
+		EXPECT_EQ(actual->turns, expected->turns) << tile.toString();
+		EXPECT_EQ(actual->moveRemains, expected->moveRemains) << tile.toString();
+		EXPECT_FLOAT_EQ(actual->getCost(), expected->getCost()) << tile.toString();
+
+		CGPath expectedPath;
+		CGPath actualPath;
+		EXPECT_EQ(fullPaths.getPath(expectedPath, tile), partialPaths.getPath(actualPath, tile));
+		EXPECT_EQ(actualPath.nodes.size(), expectedPath.nodes.size()) << tile.toString();
+	};
+
+	// single target
+	for(size_t i = 0; i < reachableTiles.size(); i += std::max<size_t>(1, reachableTiles.size() / 16))
+	{
+		CPathsInfo partialPaths(mapSize, hero);
+		calculatePathsTo(partialPaths, {reachableTiles[i]}, 0);
+		expectSameNode(partialPaths, reachableTiles[i]);
+	}
+
+	// all targets
+	std::unordered_set<int3> targets;
+	for(size_t i = 0; i < reachableTiles.size(); i += 3)
+		targets.insert(reachableTiles[i]);
+
+	{
+		CPathsInfo partialPaths(mapSize, hero);
+		calculatePathsTo(partialPaths, targets, 0);
+		for(const auto & tile : targets)
+			expectSameNode(partialPaths, tile);
+	}
+
+	// nearest targets, paths to them are final even though search stopped before reaching remaining targets
+	{
+		const size_t targetsToReach = std::min<size_t>(3, targets.size());
+		CPathsInfo partialPaths(mapSize, hero);
+		calculatePathsTo(partialPaths, targets, targetsToReach);
+
+		std::vector<int3> nearestTargets(targets.begin(), targets.end());
+		std::sort(nearestTargets.begin(), nearestTargets.end(), [&](const int3 & lhs, const int3 & rhs)
+		{
+			return fullPaths.getNode(lhs)->getCost() < fullPaths.getNode(rhs)->getCost();
+		});
+
+		// targets with the same cost as last required one may be reached in any order
+		float costLimit = fullPaths.getNode(nearestTargets[targetsToReach - 1])->getCost();
+		size_t reachedTargets = 0;
+		for(const auto & tile : nearestTargets)
+		{
+			if(fullPaths.getNode(tile)->getCost() < costLimit)
+				expectSameNode(partialPaths, tile);
+
+			const auto * node = partialPaths.getNode(tile);
+			if(node->reachable() && node->getCost() == fullPaths.getNode(tile)->getCost())
+				reachedTargets++;
+		}
+		EXPECT_GE(reachedTargets, targetsToReach);
+	}
+}
+
+/// Guards of the tile found by scan of its 3x3 neighbourhood, as CGameState did before guard index was kept by map
+static std::vector<CGObjectInstance *> scanGuardingCreatures(const CMap * map, const int3 & pos)
+{
+	std::vector<CGObjectInstance *> guards;
+	if(!map->isInTheMap(pos))
+		return guards;
+
+	const TerrainTile & posTile = map->getTile(pos);
+	for(CGObjectInstance * obj : posTile.visitableObjects)
+	{
+		if(obj->isBlockedVisitable() && obj->ID == Obj::MONSTER)
+			guards.push_back(obj);
+	}
+
+	for(int dx = -1; dx <= 1; dx++)
+	{
+		for(int dy = -1; dy <= 1; dy++)
+		{
+			int3 neighbour = pos + int3(dx, dy, 0);
+			if(!map->isInTheMap(neighbour))
+				continue;
+
+			const auto & tile = map->getTile(neighbour);
+			if(!tile.visitable || tile.isWater() != posTile.isWater())
+				continue;
+
+			for(CGObjectInstance * obj : tile.visitableObjects)
+			{
+				if(obj->ID == Obj::MONSTER && map->checkForVisitableDir(neighbour, &posTile, pos))
+					guards.push_back(obj);
+			}
+		}
+	}
+	return guards;
+}
+
+TEST_F(CGameStateTest, guardIndexIsUpdatedOnObjectChanges)
+{
+	startTestGame();
+
+	const int3 mapSize = gameState->getMapSize();
+
+	auto expectValidGuardIndex = [&](const std::string & step)
+	{
+		std::vector<std::vector<CGObjectInstance *>> incrementalGuards;
+		std::vector<int3> incrementalPositions;
+
+		for(int z = 0; z < mapSize.z; ++z)
+		{
+			for(int y = 0; y < mapSize.y; ++y)
+			{
+				for(int x = 0; x < mapSize.x; ++x)
+				{
+					int3 pos(x, y, z);
+					incrementalGuards.push_back(map->getGuardingCreatures(pos));
+					incrementalPositions.push_back(gameState->guardingCreaturePosition(pos));
+					EXPECT_EQ(gameState->guardingCreatures(pos), scanGuardingCreatures(map, pos)) << step << " " << pos.toString();
+				}
+			}
+		}
+
+		map->calculateGuardingGreaturePositions();
+
+		size_t index = 0;
+		for(int z = 0; z < mapSize.z; ++z)
+		{
+			for(int y = 0; y < mapSize.y; ++y)
+			{
+				for(int x = 0; x < mapSize.x; ++x)
+				{
+					int3 pos(x, y, z);
+					EXPECT_EQ(map->getGuardingCreatures(pos), incrementalGuards[index]) << step << " " << pos.toString();
+					EXPECT_EQ(gameState->guardingCreaturePosition(pos), incrementalPositions[index]) << step << " " << pos.toString();
+					index++;
+				}
+			}
+		}
+	};
+
+	auto createObject = [&](MapObjectID type, MapObjectSubID subtype, const int3 & visitablePosition)
+	{
+		auto handler = VLC->objtypeh->getHandlerFor(type, subtype);
+		CGObjectInstance * object = handler->create(gameState->callback, handler->getTemplates().front());
+		object->pos = visitablePosition + object->getVisitableOffset();
+
+		NewObject pack;
+		pack.newObject = object;
+		pack.initiator = PlayerColor::NEUTRAL;
+		gameCallback->sendAndApply(&pack);
+		return object->id;
+	};
+
+	auto moveObject = [&](ObjectInstanceID object, const int3 & visitablePosition)
+	{
+		ChangeObjPos pack;
+		pack.objid = object;
+		pack.nPos = visitablePosition;
+		pack.initiator = PlayerColor::NEUTRAL;
+		gameCallback->sendAndApply(&pack);
+	};
+
+	auto removeObject = [&](ObjectInstanceID object)
+	{
+		RemoveObject pack(object, PlayerColor::NEUTRAL);
+		gameCallback->sendAndApply(&pack);
+	};
+
+	expectValidGuardIndex("initial");
+
+	// heroes of test map stand in row 2, bottom rows of the map are free
+	const int3 monsterPosition(2, 6, 0);
+	const int3 minePosition(3, 5, 0);
+
+	ObjectInstanceID monster = createObject(Obj::MONSTER, CreatureID(CreatureID::ARCHER), monsterPosition);
+	expectValidGuardIndex("monster created");
+	ASSERT_FALSE(map->getGuardingCreatures(monsterPosition + int3(1, 0, 0)).empty());
+
+	// entrance of mine is next to monster, so guarding depends on directions from which mine can be visited
+	ObjectInstanceID mine = createObject(Obj::MINE, 0, minePosition);
+	expectValidGuardIndex("mine created");
+
+	moveObject(monster, int3(6, 7, 0));
+	expectValidGuardIndex("monster moved to map edge");
+
+	moveObject(monster, monsterPosition);
+	expectValidGuardIndex("monster moved back to mine");
+
+	moveObject(mine, minePosition + int3(1, 0, 0));
+	expectValidGuardIndex("mine moved");
+
+	removeObject(mine);
+	expectValidGuardIndex("mine removed");
+
+	removeObject(monster);
+	expectValidGuardIndex("monster removed");
+	EXPECT_TRUE(map->getGuardingCreatures(monsterPosition + int3(1, 0, 0)).empty());
+}
+
+TEST_F(CGameStateTest, batchedPathsMatchSequentialPaths)
+{
+	startTestGame();
+
+	const int3 mapSize = gameState->getMapSize();
+
+	// same hero may appear in batch several times, each entry writes into its own storage
+	std::vector<const CGHeroInstance *> heroes;
+	for(int i = 0; i < 3; ++i)
+		for(const auto & hero : map->heroesOnMap)
+			heroes.push_back(hero.get());
+
+	std::vector<std::unique_ptr<CPathsInfo>> expectedPaths;
+	for(const auto * hero : heroes)
+	{
+		expectedPaths.push_back(std::make_unique<CPathsInfo>(mapSize, hero));
+		gameState->calculatePaths(hero, *expectedPaths.back());
+	}
+
+	// storage is first filled with paths of another hero and then reused after reset
+	std::vector<std::unique_ptr<CPathsInfo>> batchedPaths;
+	std::vector<std::shared_ptr<PathfinderConfig>> configs;
+	for(size_t i = 0; i < heroes.size(); ++i)
+	{
+		const auto * previousHero = heroes[(i + 1) % heroes.size()];
+		batchedPaths.push_back(std::make_unique<CPathsInfo>(mapSize, previousHero));
+		gameState->calculatePaths(previousHero, *batchedPaths.back());
+
+		batchedPaths.back()->reset(heroes[i]);
+		configs.push_back(std::make_shared<SingleHeroPathfinderConfig>(*batchedPaths.back(), gameState.get(), heroes[i]));
+	}
+
+	gameState->calculatePaths(configs);
+
+	for(size_t i = 0; i < heroes.size(); ++i)
+	{
+		const auto & expected = *expectedPaths[i];
+		const auto & actual = *batchedPaths[i];
+
+		EXPECT_EQ(actual.hero, expected.hero);
+		EXPECT_EQ(actual.hpos, expected.hpos);
+		ASSERT_EQ(actual.nodes.num_elements(), expected.nodes.num_elements());
+
+		for(size_t n = 0; n < expected.nodes.num_elements(); ++n)
+		{
+			const CGPathNode & expectedNode = expected.nodes.data()[n];
+			const CGPathNode & actualNode = actual.nodes.data()[n];
+			const std::string nodeName = "hero " + std::to_string(i) + " node " + expectedNode.coord.toString() + " layer " + std::to_string(expectedNode.layer.getNum());
+
+			EXPECT_EQ(actualNode.coord, expectedNode.coord) << nodeName;
+			EXPECT_EQ(actualNode.layer, expectedNode.layer) << nodeName;
+			EXPECT_EQ(actualNode.cost, expectedNode.cost) << nodeName;
+			EXPECT_EQ(actualNode.moveRemains, expectedNode.moveRemains) << nodeName;
+			EXPECT_EQ(actualNode.turns, expectedNode.turns) << nodeName;
+			EXPECT_EQ(actualNode.accessible, expectedNode.accessible) << nodeName;
+			EXPECT_EQ(actualNode.action, expectedNode.action) << nodeName;
+			EXPECT_EQ(actualNode.locked, expectedNode.locked) << nodeName;
+			EXPECT_FALSE(actualNode.inPQ()) << nodeName;
+
+			// previous nodes are compared by their position in storage
+			auto previousIndex = [](const CPathsInfo & paths, const CGPathNode & node) -> ptrdiff_t
+			{
+				return node.theNodeBefore ? node.theNodeBefore - paths.nodes.data() : -1;
+			};
+			EXPECT_EQ(previousIndex(actual, actualNode), previousIndex(expected, expectedNode)) << nodeName;
+		}
+	}
+}
+
+TEST_F(CGameStateTest, tilesInRangeMatchDistance)
+{
+	startTestGame();
+
+	const int3 mapSize = gameState->getMapSize();
+	const int3 last(mapSize.x - 1, mapSize.y - 1, 0);
+
+	const std::vector<int3> positions = {
+		int3(0, 0, 0), int3(last.x, 0, 0), int3(0, last.y, 0), last,
+		int3(last.x / 2, 0, 0), int3(0, last.y / 2, 0), int3(last.x, last.y / 2, 0), int3(last.x / 2, last.y, 0),
+		int3(last.x / 2, last.y / 2, 0)
+	};
+
+	for(auto formula : {int3::DIST_2D, int3::DIST_MANHATTAN, int3::DIST_CHEBYSHEV, int3::DIST_2DSQ})
+	{
+		for(int radius : {0, 1, 2, 3, 4, 5, 8, 13})
+		{
+			for(const auto & pos : positions)
+			{
+				const std::string caseName = "formula " + std::to_string(formula) + " radius " + std::to_string(radius) + " at " + pos.toString();
+
+				std::unordered_set<int3> expected;
+				for(int x = 0; x < mapSize.x; ++x)
+					for(int y = 0; y < mapSize.y; ++y)
+						if(pos.dist(int3(x, y, pos.z), formula) <= radius)
+							expected.insert(int3(x, y, pos.z));
+
+				std::unordered_set<int3> tiles;
+				gameCallback->getTilesInRange(tiles, pos, radius, ETileVisibility::REVEALED, std::nullopt, formula);
+				EXPECT_EQ(tiles, expected) << caseName;
+
+				boost::multi_array<ui8, 3> fogOfWar(boost::extents[mapSize.z][mapSize.x][mapSize.y]);
+				std::fill(fogOfWar.data(), fogOfWar.data() + fogOfWar.num_elements(), 0);
+				gameCallback->revealTilesInRange(fogOfWar, pos, radius, formula);
+
+				for(int z = 0; z < mapSize.z; ++z)
+					for(int x = 0; x < mapSize.x; ++x)
+						for(int y = 0; y < mapSize.y; ++y)
+							EXPECT_EQ(fogOfWar[z][x][y] != 0, vstd::contains(expected, int3(x, y, z))) << caseName << " tile " << int3(x, y, z).toString();
+			}
+		}
+	}
+}
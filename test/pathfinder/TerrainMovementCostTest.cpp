@@ -0,0 +1,160 @@
+/*
+ * TerrainMovementCostTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/VCMI_Lib.h"
+#include "../../lib/CCreatureSet.h"
+#include "../../lib/RoadHandler.h"
+#include "../../lib/TerrainHandler.h"
+#include "../../lib/bonuses/Bonus.h"
+#include "../../lib/bonuses/BonusSelector.h"
+#include "../../lib/mapObjects/CGHeroInstance.h"
+#include "../../lib/mapping/CMapDefines.h"
+#include "../../lib/pathfinder/TurnInfo.h"
+
+namespace test
+{
+
+class TerrainMovementCostTest : public ::testing::Test
+{
+public:
+	std::unique_ptr<CGHeroInstance> hero;
+
+	void SetUp() override
+	{
+		hero = std::make_unique<CGHeroInstance>(nullptr);
+	}
+
+	void addStack(SlotID slot, CreatureID creature)
+	{
+		hero->putStack(slot, new CStackInstance(creature, 10));
+	}
+
+	void addBonus(BonusType type, si32 value, BonusSubtypeID subtype = BonusSubtypeID())
+	{
+		hero->addNewBonus(std::make_shared<Bonus>(BonusDuration::PERMANENT, type, BonusSource::OTHER, value, BonusSourceID(), subtype));
+	}
+
+	/// Movement cost formula used before costs were precomputed by TurnInfo
+	static ui32 referenceCost(const TerrainTile & dest, const TerrainTile & from, const TurnInfo * ti)
+	{
+		int64_t ret = GameConstants::BASE_MOVEMENT_COST;
+
+		if(dest.roadType->getId() != Road::NO_ROAD && from.roadType->getId() != Road::NO_ROAD)
+		{
+			ret = from.roadType->movementCost;
+		}
+		else if(ti->nativeTerrain != from.terType->getId() &&
+				ti->nativeTerrain != ETerrainId::ANY_TERRAIN &&
+				!ti->hasBonusOfType(BonusType::NO_TERRAIN_PENALTY, BonusSubtypeID(from.terType->getId())))
+		{
+			ret = VLC->terrainTypeHandler->getById(from.terType->getId())->moveCost;
+			ret -= ti->valOfBonuses(BonusType::ROUGH_TERRAIN_DISCOUNT);
+			if(ret < GameConstants::BASE_MOVEMENT_COST)
+				ret = GameConstants::BASE_MOVEMENT_COST;
+		}
+		return static_cast<ui32>(ret);
+	}
+
+	/// Compares movement cost between every pair of terrains, with and without roads
+	void checkAllTerrains(const TurnInfo & ti) const
+	{
+		const auto * noRoad = VLC->roadTypeHandler->getById(Road::NO_ROAD);
+		const auto * road = VLC->roadTypeHandler->getById(Road::DIRT_ROAD);
+
+		for(const auto & fromTerrain : VLC->terrainTypeHandler->objects)
+		{
+			for(const auto & destTerrain : VLC->terrainTypeHandler->objects)
+			{
+				for(const auto * fromRoad : {noRoad, road})
+				{
+					for(const auto * destRoad : {noRoad, road})
+					{
+						TerrainTile from;
+						TerrainTile dest;
+						from.terType = fromTerrain.get();
+						from.roadType = fromRoad;
+						dest.terType = destTerrain.get();
+						dest.roadType = destRoad;
+
+						EXPECT_EQ(hero->getTileMovementCost(dest, from, &ti), referenceCost(dest, from, &ti))
+							<< "from " << fromTerrain->getJsonKey() << " to " << destTerrain->getJsonKey()
+							<< ", roads: " << fromRoad->getJsonKey() << " -> " << destRoad->getJsonKey();
+					}
+				}
+			}
+		}
+	}
+};
+
+TEST_F(TerrainMovementCostTest, EmptyArmyIgnoresTerrain)
+{
+	TurnInfo ti(hero.get());
+	EXPECT_EQ(ti.nativeTerrain, ETerrainId::ANY_TERRAIN);
+	checkAllTerrains(ti);
+}
+
+TEST_F(TerrainMovementCostTest, NativeTerrain)
+{
+	addStack(SlotID(0), CreatureID::ARCHER);
+
+	TurnInfo ti(hero.get());
+	EXPECT_NE(ti.nativeTerrain, ETerrainId::ANY_TERRAIN);
+	EXPECT_NE(ti.nativeTerrain, ETerrainId::NONE);
+	checkAllTerrains(ti);
+}
+
+TEST_F(TerrainMovementCostTest, MixedArmyHasNoNativeTerrain)
+{
+	addStack(SlotID(0), CreatureID::ARCHER);
+	addStack(SlotID(1), CreatureID::TROGLODYTES);
+
+	TurnInfo ti(hero.get());
+	EXPECT_EQ(ti.nativeTerrain, ETerrainId::NONE);
+	checkAllTerrains(ti);
+}
+
+TEST_F(TerrainMovementCostTest, NoTerrainPenalty)
+{
+	addStack(SlotID(0), CreatureID::ARCHER);
+	addBonus(BonusType::NO_TERRAIN_PENALTY, 0, BonusSubtypeID(TerrainId(ETerrainId::SAND)));
+	addBonus(BonusType::NO_TERRAIN_PENALTY, 0, BonusSubtypeID(TerrainId(ETerrainId::SWAMP)));
+
+	TurnInfo ti(hero.get());
+	checkAllTerrains(ti);
+}
+
+TEST_F(TerrainMovementCostTest, RoughTerrainDiscount)
+{
+	addStack(SlotID(0), CreatureID::ARCHER);
+	addBonus(BonusType::ROUGH_TERRAIN_DISCOUNT, 50);
+	addBonus(BonusType::NO_TERRAIN_PENALTY, 0, BonusSubtypeID(TerrainId(ETerrainId::SNOW)));
+
+	TurnInfo ti(hero.get());
+	checkAllTerrains(ti);
+}
+
+TEST_F(TerrainMovementCostTest, RoughTerrainDiscountUpdate)
+{
+	addStack(SlotID(0), CreatureID::ARCHER);
+
+	TurnInfo ti(hero.get());
+	checkAllTerrains(ti);
+
+	// hero gains pathfinding skill during turn: bonus list is reloaded first, then cached discount is refreshed
+	addBonus(BonusType::ROUGH_TERRAIN_DISCOUNT, 75);
+	ti.updateHeroBonuses(BonusType::MOVEMENT, Selector::all);
+	ti.updateHeroBonuses(BonusType::ROUGH_TERRAIN_DISCOUNT, Selector::all);
+	EXPECT_EQ(ti.valOfBonuses(BonusType::ROUGH_TERRAIN_DISCOUNT), 75);
+	checkAllTerrains(ti);
+}
+
+}
@@ -0,0 +1,174 @@
+/*
+ * BinarySerializerTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/serializer/BinaryDeserializer.h"
+#include "../../lib/serializer/BinarySerializer.h"
+
+namespace test
+{
+
+/// In-memory buffer that exposes serialized bytes for comparison
+class TestBuffer : public IBinaryReader, public IBinaryWriter
+{
+public:
+	std::vector<std::byte> data;
+	size_t readPosition = 0;
+
+	BinarySerializer saver;
+	BinaryDeserializer loader;
+
+	TestBuffer()
+		: saver(this)
+		, loader(this)
+	{
+		loader.version = ESerializationVersion::CURRENT;
+	}
+
+	int read(std::byte * target, unsigned size) override
+	{
+		if(readPosition + size > data.size())
+			throw std::runtime_error("Attempt to read past the end of buffer!");
+
+		std::copy_n(data.data() + readPosition, size, target);
+		readPosition += size;
+		return size;
+	}
+
+	int write(const std::byte * source, unsigned size) override
+	{
+		data.insert(data.end(), source, source + size);
+		return size;
+	}
+};
+
+class BinarySerializerTest : public ::testing::Test
+{
+public:
+	std::vector<ui8> bytes;
+	std::array<float, 7> floats;
+	boost::multi_array<ui8, 3> fogOfWar;
+	std::vector<int> integers;
+
+	void SetUp() override
+	{
+		for(int i = 0; i < 300; ++i)
+			bytes.push_back(i * 37 % 256);
+
+		for(size_t i = 0; i < floats.size(); ++i)
+			floats[i] = 1.5f - static_cast<float>(i) * 0.3f;
+
+		fogOfWar.resize(boost::extents[3][4][2]);
+		for(size_t i = 0; i < fogOfWar.num_elements(); ++i)
+			fogOfWar.data()[i] = i % 3 == 0;
+
+		integers = {0, 1, -1, 63, 64, -64, 100000, std::numeric_limits<int>::max(), std::numeric_limits<int>::min() + 1};
+	}
+
+	/// Serializes test data one element at a time, as serializer did before bulk copying was introduced
+	void saveElementWise(BinarySerializer & saver) const
+	{
+		uint32_t bytesSize = bytes.size();
+		saver & bytesSize;
+		for(const auto & element : bytes)
+			saver & element;
+
+		for(const auto & element : floats)
+			saver & element;
+
+		uint32_t fogSize = fogOfWar.num_elements();
+		uint32_t x = fogOfWar.shape()[0];
+		uint32_t y = fogOfWar.shape()[1];
+		uint32_t z = fogOfWar.shape()[2];
+		saver & fogSize & x & y & z;
+		for(size_t i = 0; i < fogOfWar.num_elements(); ++i)
+			saver & fogOfWar.data()[i];
+
+		uint32_t integersSize = integers.size();
+		saver & integersSize;
+		for(const auto & element : integers)
+			saver & element;
+	}
+
+	void saveContainers(BinarySerializer & saver) const
+	{
+		saver & bytes & floats & fogOfWar & integers;
+	}
+
+	void loadAndCompare(BinaryDeserializer & loader) const
+	{
+		std::vector<ui8> loadedBytes;
+		std::array<float, 7> loadedFloats;
+		boost::multi_array<ui8, 3> loadedFogOfWar;
+		std::vector<int> loadedIntegers;
+
+		loader & loadedBytes & loadedFloats & loadedFogOfWar & loadedIntegers;
+
+		EXPECT_EQ(loadedBytes, bytes);
+		EXPECT_EQ(loadedFloats, floats);
+		EXPECT_EQ(loadedFogOfWar, fogOfWar);
+		EXPECT_EQ(loadedIntegers, integers);
+	}
+};
+
+TEST_F(BinarySerializerTest, ContainersMatchElementWiseFormat)
+{
+	TestBuffer bulk;
+	TestBuffer elementWise;
+
+	saveContainers(bulk.saver);
+	saveElementWise(elementWise.saver);
+
+	EXPECT_EQ(bulk.data, elementWise.data);
+}
+
+TEST_F(BinarySerializerTest, ContainersRoundTrip)
+{
+	TestBuffer buffer;
+
+	saveContainers(buffer.saver);
+	loadAndCompare(buffer.loader);
+
+	EXPECT_EQ(buffer.readPosition, buffer.data.size());
+}
+
+TEST_F(BinarySerializerTest, ContainersRoundTripWithReversedEndianness)
+{
+	TestBuffer buffer;
+
+	// emulate data written on platform with different endianness:
+	// variable-length integers and bytes are not affected, only floating point values are stored in reversed byte order
+	{
+		uint32_t bytesSize = bytes.size();
+		buffer.saver & bytesSize;
+		for(const auto & element : bytes)
+			buffer.saver & element;
+
+		for(const auto & element : floats)
+		{
+			std::array<std::byte, sizeof(float)> reversed;
+			std::copy_n(reinterpret_cast<const std::byte *>(&element), sizeof(float), reversed.begin());
+			std::reverse(reversed.begin(), reversed.end());
+			buffer.write(reversed.data(), reversed.size());
+		}
+
+		TestBuffer tail;
+		tail.saver & fogOfWar & integers;
+		buffer.write(tail.data.data(), tail.data.size());
+	}
+
+	buffer.loader.reverseEndianness = true;
+	loadAndCompare(buffer.loader);
+
+	EXPECT_EQ(buffer.readPosition, buffer.data.size());
+}
+
+}
@@ -0,0 +1,221 @@
+/*
+ * CSaveLoadFileTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+
+#include "../../lib/serializer/CLoadFile.h"
+#include "../../lib/serializer/CSaveFile.h"
+
+namespace test
+{
+
+class CSaveLoadFileTest : public ::testing::Test
+{
+public:
+	boost::filesystem::path filename;
+
+	void SetUp() override
+	{
+		filename = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vcmi-test-%%%%-%%%%.vsgm1");
+	}
+
+	void TearDown() override
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove(filename, ec);
+	}
+
+	static std::vector<std::byte> makePattern(size_t size, uint8_t seed)
+	{
+		std::vector<std::byte> result(size);
+		for(size_t i = 0; i < size; ++i)
+			result[i] = static_cast<std::byte>((i * 7 + seed) & 0xff);
+		return result;
+	}
+};
+
+static std::vector<char> readFileData(const boost::filesystem::path & filename)
+{
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static void writeFileData(const boost::filesystem::path & filename, const std::vector<char> & data)
+{
+	std::ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+	file.write(data.data(), data.size());
+}
+
+TEST_F(CSaveLoadFileTest, RoundTripOfMultipleSections)
+{
+	std::string header = "map header";
+	std::vector<int> values = {1, -2, 300000, std::numeric_limits<int>::min()};
+	std::map<std::string, si64> entries = {{"first", 1}, {"second", -1234567890}};
+
+	{
+		CSaveFile save(filename);
+		save << header;
+		save.beginSection();
+		save << values;
+		save.beginSection();
+		save << entries;
+		save.writeToFile();
+	}
+
+	CLoadFile load(filename);
+
+	std::string loadedHeader;
+	std::vector<int> loadedValues;
+	std::map<std::string, si64> loadedEntries;
+	load >> loadedHeader >> loadedValues >> loadedEntries;
+
+	EXPECT_EQ(loadedHeader, header);
+	EXPECT_EQ(loadedValues, values);
+	EXPECT_EQ(loadedEntries, entries);
+}
+
+TEST_F(CSaveLoadFileTest, ReadAcrossSectionBoundaries)
+{
+	auto first = makePattern(100, 1);
+	auto second = makePattern(10, 2);
+	auto third = makePattern(100000, 3);
+
+	{
+		CSaveFile save(filename);
+		save.write(first.data(), first.size());
+		save.beginSection();
+		save.write(second.data(), second.size());
+		save.beginSection();
+		save.beginSection(); // empty sections must be skipped
+		save.write(third.data(), third.size());
+		save.writeToFile();
+	}
+
+	std::vector<std::byte> expected;
+	expected.insert(expected.end(), first.begin(), first.end());
+	expected.insert(expected.end(), second.begin(), second.end());
+	expected.insert(expected.end(), third.begin(), third.end());
+
+	CLoadFile load(filename);
+
+	// first read ends in the middle of first section, second one spans all three sections
+	std::vector<std::byte> loaded(expected.size());
+	load.read(loaded.data(), 50);
+	load.read(loaded.data() + 50, 100);
+	load.read(loaded.data() + 150, loaded.size() - 150);
+
+	EXPECT_EQ(loaded, expected);
+
+	std::byte extra;
+	EXPECT_THROW(load.read(&extra, 1), std::runtime_error);
+}
+
+TEST_F(CSaveLoadFileTest, DecompressAllSections)
+{
+	std::vector<std::string> values;
+	{
+		CSaveFile save(filename);
+		for(int i = 0; i < 16; ++i)
+		{
+			values.push_back("section " + std::to_string(i));
+			save << values.back();
+			save.beginSection();
+		}
+		save.writeToFile();
+	}
+
+	CLoadFile load(filename);
+
+	std::string loaded;
+	load >> loaded;
+	EXPECT_EQ(loaded, values.front());
+
+	load.decompressAllSections();
+	for(size_t i = 1; i < values.size(); ++i)
+	{
+		load >> loaded;
+		EXPECT_EQ(loaded, values[i]);
+	}
+}
+
+TEST_F(CSaveLoadFileTest, LoadUnsectionedFile)
+{
+	std::string header = "map header";
+	std::vector<int> values(100000);
+	std::iota(values.begin(), values.end(), -50000);
+
+	// files in older format contain preamble followed by uncompressed data
+	{
+		CSaveFile save(filename);
+		save << header << values;
+
+		ESerializationVersion oldVersion = ESerializationVersion::REWARDABLE_BANKS;
+		std::copy_n(reinterpret_cast<const std::byte *>(&oldVersion), sizeof(oldVersion), save.buffer.begin() + 4);
+
+		std::ofstream file(filename.c_str(), std::ios::binary);
+		file.write(reinterpret_cast<const char *>(save.buffer.data()), save.buffer.size());
+	}
+
+	EXPECT_THROW(CLoadFile{filename}, std::runtime_error);
+
+	CLoadFile load(filename, ESerializationVersion::MINIMAL);
+	EXPECT_EQ(load.serializer.version, ESerializationVersion::REWARDABLE_BANKS);
+
+	std::string loadedHeader;
+	std::vector<int> loadedValues;
+	load >> loadedHeader >> loadedValues;
+
+	EXPECT_EQ(loadedHeader, header);
+	EXPECT_EQ(loadedValues, values);
+}
+
+TEST_F(CSaveLoadFileTest, RejectCorruptedTableOfContents)
+{
+	{
+		CSaveFile save(filename);
+		save << std::string("some data");
+		save.beginSection();
+		save << std::string("more data");
+		save.writeToFile();
+	}
+
+	const auto original = readFileData(filename);
+	// table of contents follows 8 bytes of preamble: number of sections, then compressed and uncompressed size of each section
+	const size_t sectionsCountOffset = 8;
+	const size_t compressedSizeOffset = 12;
+	const size_t uncompressedSizeOffset = 16;
+
+	auto corrupt = [&](size_t offset, uint32_t value)
+	{
+		auto data = original;
+		for(size_t i = 0; i < 4; ++i)
+			data[offset + i] = static_cast<char>((value >> (i * 8)) & 0xff);
+		writeFileData(filename, data);
+	};
+
+	corrupt(sectionsCountOffset, 0xffffffff);
+	EXPECT_THROW(CLoadFile{filename}, std::runtime_error);
+
+	corrupt(compressedSizeOffset, 0x7fffffff);
+	EXPECT_THROW(CLoadFile{filename}, std::runtime_error);
+
+	corrupt(uncompressedSizeOffset, 0xffffffff);
+	EXPECT_THROW(CLoadFile{filename}, std::runtime_error);
+
+	auto truncated = original;
+	truncated.resize(truncated.size() - 1);
+	writeFileData(filename, truncated);
+	EXPECT_THROW(CLoadFile{filename}, std::runtime_error);
+
+	writeFileData(filename, original);
+	EXPECT_NO_THROW(CLoadFile{filename});
+}
+
+}